@@ -0,0 +1,223 @@
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// On-disk layout of assets.pak (built by pack_assets.cpp):
+//
+//   PackHeader
+//   PackEntry[entry_count]
+//   name table (entry names, not null terminated)
+//   data blobs, each starting on a PACK_ALIGNMENT boundary
+//
+// Entries with identical contents share one blob, which is how the
+// duplicated root / Assets/ copies of the same file stay free. Each entry
+// also records the HashAssetBytes() of its contents, so a cooked texture
+// can be matched to its packed PNG without reading the PNG.
+
+#define PACK_MAGIC "DDPK"
+#define PACK_VERSION 2
+#define PACK_ALIGNMENT 16
+
+// Content hash shared by the pack and cook tools. Consumes 8 bytes per step,
+// so hashing a multi-megabyte PNG stays far cheaper than decoding it.
+inline uint64_t HashAssetBytes(const unsigned char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL ^ (uint64_t)size;
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t name_table_size;
+};
+
+struct PackEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t hash;
+    uint32_t name_offset;
+    uint32_t name_length;
+};
+
+class AssetPack {
+public:
+    static AssetPack* GetInstance() {
+        static AssetPack instance;
+        return &instance;
+    }
+
+    bool Open(const std::string& path) {
+        Close();
+
+        if (!MapFile(path)) {
+            std::cout << "No asset pack found at " << path << ", using loose files" << std::endl;
+            return false;
+        }
+
+        if (mapped_size < sizeof(PackHeader)) {
+            std::cerr << "ERROR: Asset pack " << path << " is truncated" << std::endl;
+            Close();
+            return false;
+        }
+
+        const PackHeader* header = (const PackHeader*)mapped;
+        if (std::memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != PACK_VERSION) {
+            std::cerr << "ERROR: Asset pack " << path << " has an unknown format" << std::endl;
+            Close();
+            return false;
+        }
+
+        size_t table_end = sizeof(PackHeader) + (size_t)header->entry_count * sizeof(PackEntry) + header->name_table_size;
+        if (table_end > mapped_size) {
+            std::cerr << "ERROR: Asset pack " << path << " has a corrupt index" << std::endl;
+            Close();
+            return false;
+        }
+
+        const PackEntry* entries = (const PackEntry*)(mapped + sizeof(PackHeader));
+        const char* names = (const char*)(entries + header->entry_count);
+
+        index.reserve(header->entry_count);
+        for (uint32_t i = 0; i < header->entry_count; i++) {
+            const PackEntry& entry = entries[i];
+            if (entry.offset + entry.size > mapped_size ||
+                entry.name_offset + entry.name_length > header->name_table_size) {
+                std::cerr << "ERROR: Asset pack entry " << i << " is out of bounds" << std::endl;
+                continue;
+            }
+            index[std::string(names + entry.name_offset, entry.name_length)] = entry;
+        }
+
+        std::cout << "Opened asset pack " << path << " with " << index.size() << " entries" << std::endl;
+        return true;
+    }
+
+    void Close() {
+        index.clear();
+
+#ifndef _WIN32
+        if (mapped != nullptr) {
+            munmap((void*)mapped, mapped_size);
+        }
+#else
+        fallback_data.clear();
+        fallback_data.shrink_to_fit();
+#endif
+        mapped = nullptr;
+        mapped_size = 0;
+    }
+
+    bool IsOpen() const {
+        return mapped != nullptr;
+    }
+
+    bool Contains(const std::string& name) const {
+        return index.find(name) != index.end();
+    }
+
+    // Returns a pointer straight into the mapped pack. The memory stays valid
+    // until Close(), so it can back streamed music as well as one-shot decodes.
+    const unsigned char* GetData(const std::string& name, int* size) const {
+        auto it = index.find(name);
+        if (it == index.end()) {
+            if (size) *size = 0;
+            return nullptr;
+        }
+
+        if (size) *size = (int)it->second.size;
+        return mapped + it->second.offset;
+    }
+
+    // Content hash recorded by pack_assets, without touching the data
+    bool GetHash(const std::string& name, uint64_t* hash) const {
+        auto it = index.find(name);
+        if (it == index.end()) return false;
+
+        *hash = it->second.hash;
+        return true;
+    }
+
+    ~AssetPack() {
+        Close();
+    }
+
+private:
+    AssetPack() {}
+    AssetPack(const AssetPack&) = delete;
+    void operator=(const AssetPack&) = delete;
+
+    bool MapFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return false;
+
+        mapped = (const unsigned char*)data;
+        mapped_size = (size_t)info.st_size;
+        return true;
+#else
+        // No mmap here; read the whole pack once instead of one open per asset
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+
+        std::streamsize length = file.tellg();
+        if (length <= 0) return false;
+        file.seekg(0);
+
+        fallback_data.resize((size_t)length);
+        if (!file.read((char*)fallback_data.data(), length)) {
+            fallback_data.clear();
+            return false;
+        }
+
+        mapped = fallback_data.data();
+        mapped_size = fallback_data.size();
+        return true;
+#endif
+    }
+
+    const unsigned char* mapped = nullptr;
+    size_t mapped_size = 0;
+    std::unordered_map<std::string, PackEntry> index;
+
+#ifdef _WIN32
+    std::vector<unsigned char> fallback_data;
+#endif
+};
+
+#endif
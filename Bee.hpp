@@ -21,7 +21,6 @@ public:
 
 class BeeWandering : public BeeState {
 public:
-    float change_direction_cooldown;
     Vector2 move_direction;
     void Enter(Bee& bee);
     void Update(Bee& bee, float delta_time);
@@ -35,9 +34,10 @@ public:
     void HandleCollision(Bee& bee, Entity* other_entity);
 };
 
+#define BEE_WINDUP_TIME 1.0f
+
 class BeeReady : public BeeState {
 public:
-    float ready_timer;
     Vector2 aim_direction;
     void Enter(Bee& bee);
     void Update(Bee& bee, float delta_time);
@@ -86,6 +86,14 @@ public:
 
     void HandleCollision(Entity* other_entity) override;
 
+    void WriteSnapshot(SnapshotWriter& writer) override;
+    void ReadSnapshot(SnapshotReader& reader, Entity* player) override;
+
+    template <typename Archive>
+    void Snapshot(Archive& archive, Entity* player);
+
+    static Behavior Windup(Bee& bee, float seconds);
+
 private:
     BeeState* current_state;
     bool flash_visible;
@@ -72,6 +72,7 @@ void Bee::Draw() {
 
 
 void Bee::SetState(BeeState* new_state) {
+    StopBehavior();
     current_state = new_state;
     current_state->Enter(*this);
 }
@@ -87,6 +88,7 @@ Bee::Bee(Vector2 pos, float spd, float rad, float d_radius, float a_radius, floa
     health = hp;
     maxHealth = hp;
     active = true;
+    enemyID = ENEMY_BEE;
 
     detection_radius = d_radius;
     aggro_radius = a_radius;
@@ -97,7 +99,10 @@ Bee::Bee(Vector2 pos, float spd, float rad, float d_radius, float a_radius, floa
     flash_interval = 0.1f;
     
 
-    sprite = LoadTexture(GAME_SCENE_SPRITE_BEE);
+    static ResourceHandle shared_sprite;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    sprite_handle = resources->AcquireShared(shared_sprite, GAME_SCENE_SPRITE_BEE, ResourceType::TEXTURE);
+    sprite = resources->GetTexture(sprite_handle).texture;
     frameWidth = sprite.width / 6.0f;
     frameHeight = sprite.height / 4.0f;
     maxFrames = 6;
@@ -112,11 +117,9 @@ void BeeWandering::Enter(Bee& bee) {
     std::cout << "Entering wandering state for Bee. Texture ID: " << bee.sprite.id << std::endl;
 
     bee.color = VIOLET;
-    change_direction_cooldown = GetRandomValue(1, 3);
-    move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-    move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-
-    move_direction = Vector2Normalize(move_direction);
+    float first_turn = GetRandomValue(1, 3);
+    move_direction = BaseEnemy::RandomDirection();
+    bee.RunBehavior(BaseEnemy::WanderTurns(move_direction, first_turn));
     bee.entity_following = nullptr;
 
     bee.currentFrame = 0;
@@ -129,9 +132,14 @@ void BeeChasing::Enter(Bee& bee) {
 
 void BeeReady::Enter(Bee& bee) {
     bee.color = ORANGE;
-    ready_timer = 1.0f;
     bee.currentFrame = 3;
     bee.maxFrames = 1;
+    bee.RunBehavior(Bee::Windup(bee, BEE_WINDUP_TIME));
+}
+
+Behavior Bee::Windup(Bee& bee, float seconds) {
+    co_await Behavior::Delay(seconds);
+    bee.SetState(&bee.attacking);
 }
 
 void BeeAttacking::Enter(Bee& bee) {
@@ -146,20 +154,6 @@ void BeeAttacking::Enter(Bee& bee) {
 
 
 void BeeWandering::Update(Bee& bee, float delta_time) {
-    bee.velocity = Vector2Zero();
-
-    if (change_direction_cooldown <= 0.0f) {
-        move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-        move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-
-        move_direction = Vector2Normalize(move_direction);
-        
-        change_direction_cooldown = GetRandomValue(1, 3);
-    }
-    else {
-        change_direction_cooldown -= delta_time;
-    }
-
     bee.velocity = Vector2Scale(move_direction, 50.0f);
 
     if (abs(bee.velocity.x) > abs(bee.velocity.y)){
@@ -178,19 +172,19 @@ void BeeWandering::Update(Bee& bee, float delta_time) {
         }
     }
 
+    bee.velocity = Vector2Add(bee.velocity, bee.separation);
+
     Vector2 new_position = Vector2Add(bee.position, Vector2Scale(bee.velocity, delta_time));
 
-    Bee temp_enemy = bee;
+    Entity temp_enemy = bee;
     temp_enemy.position = new_position;
 
     if (bee.tile_map && !bee.tile_map->CheckTileCollision(&temp_enemy)) {
         bee.position = new_position;
     } else {
         // Pick a new random direction if collision happens
-        move_direction.x = GetRandomValue(-100, 100) / 100.0f;
-        move_direction.y = GetRandomValue(-100, 100) / 100.0f;
-        move_direction = Vector2Normalize(move_direction);
-        change_direction_cooldown = GetRandomValue(1, 3);  // reset cooldown
+        move_direction = BaseEnemy::RandomDirection();
+        bee.RunBehavior(BaseEnemy::WanderTurns(move_direction, GetRandomValue(1, 3)));  // reset cooldown
     }
     
 
@@ -204,7 +198,7 @@ void BeeWandering::Update(Bee& bee, float delta_time) {
 }
 
 void BeeWandering::HandleCollision(Bee& bee, Entity* other_entity) {
-    if (CheckCollisionCircles(bee.position, bee.detection_radius, other_entity->position, other_entity->radius)) {
+    if (CheckCollisionCircles(bee.position, bee.detection_radius, other_entity->position, other_entity->radius) && bee.CanSeePlayer()) {
         bee.entity_following = other_entity;
         bee.SetState(&bee.chasing);
     }
@@ -232,8 +226,10 @@ void BeeChasing::Update(Bee& bee, float delta_time) {
         }
     }
     
+    bee.velocity = Vector2Add(bee.velocity, bee.separation);
+
     Vector2 new_position = Vector2Add(bee.position, Vector2Scale(bee.velocity, delta_time));
-    Bee temp_enemy = bee;
+    Entity temp_enemy = bee;
     temp_enemy.position = new_position;
     
     if (bee.tile_map && !bee.tile_map->CheckTileCollision(&temp_enemy)) {
@@ -252,7 +248,8 @@ void BeeChasing::Update(Bee& bee, float delta_time) {
 }
 
 void BeeChasing::HandleCollision(Bee& bee, Entity* other_entity) {
-    if (CheckCollisionCircles(bee.position, bee.ready_attack_radius, other_entity->position, other_entity->radius)) {
+    if (CheckCollisionCircles(bee.position, bee.ready_attack_radius, other_entity->position, other_entity->radius) &&
+        bee.HasLineOfSight(other_entity->position)) {
         bee.SetState(&bee.ready);
     }
     
@@ -265,14 +262,6 @@ void BeeReady::Update(Bee& bee, float delta_time) {
     aim_direction = Vector2Subtract(bee.entity_following->position, bee.position);
     aim_direction = Vector2Normalize(aim_direction);
 
-
-    if (!(ready_timer <= 0.0f)) {
-        ready_timer -= delta_time;
-    }
-    else {
-        bee.SetState(&bee.attacking);
-    }
-
     if (bee.invulnerable_timer > 0.0f) {
         bee.invulnerable_timer -= delta_time;
     }
@@ -306,7 +295,7 @@ void BeeAttacking::Update(Bee& bee, float delta_time) {
     }
 
     Vector2 new_position = Vector2Add(bee.position, Vector2Scale(bee.velocity, delta_time));
-    Bee temp_enemy = bee;
+    Entity temp_enemy = bee;
     temp_enemy.position = new_position;
 
     if (bee.tile_map && !bee.tile_map->CheckTileCollision(&temp_enemy)) {
@@ -334,4 +323,48 @@ void BeeAttacking::Update(Bee& bee, float delta_time) {
 }
 
 void BeeAttacking::HandleCollision(Bee& bee, Entity* other_entity) {
-}
\ No newline at end of file
+}
+
+template <typename Archive>
+void Bee::Snapshot(Archive& archive, Entity* player) {
+    SnapshotBase(archive, player);
+
+    BeeState* states[] = { &wandering, &chasing, &ready, &attacking };
+    int state = 0;
+    for (int i = 0; i < 4; i++) {
+        if (current_state == states[i]) state = i;
+    }
+    archive.Value(state);
+    if (Archive::reading) current_state = states[(state >= 0 && state < 4) ? state : 0];
+
+    // The coroutine's frame isn't saved, only how long its delay had left
+    float change_direction_cooldown = current_state == &wandering ? BehaviorRemaining() : 0.0f;
+    float ready_timer = current_state == &ready ? BehaviorRemaining() : 0.0f;
+    archive.Value(change_direction_cooldown);
+    archive.Value(wandering.move_direction);
+    archive.Value(ready_timer);
+    archive.Value(ready.aim_direction);
+    archive.Value(attacking.attack_direction);
+    archive.Value(animation_state);
+    archive.Value(flash_visible);
+    archive.Value(flash_timer);
+    archive.Value(flash_interval);
+
+    if (Archive::reading) {
+        if (current_state == &wandering) {
+            RunBehavior(BaseEnemy::WanderTurns(wandering.move_direction, change_direction_cooldown));
+        } else if (current_state == &ready) {
+            RunBehavior(Windup(*this, ready_timer));
+        } else {
+            StopBehavior();
+        }
+    }
+}
+
+void Bee::WriteSnapshot(SnapshotWriter& writer) {
+    Snapshot(writer, nullptr);
+}
+
+void Bee::ReadSnapshot(SnapshotReader& reader, Entity* player) {
+    Snapshot(reader, player);
+}
@@ -0,0 +1,410 @@
+#ifndef BEHAVIOR_HPP
+#define BEHAVIOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <vector>
+
+// Coroutine behaviors for enemies. A behavior is a function returning
+// Behavior that co_awaits what it is waiting for instead of keeping its own
+// countdown and checking it every frame:
+//
+//   co_await Behavior::Delay(1.0f);                 // game seconds
+//   co_await Behavior::Until(signal, predicate);    // when 'signal' fires
+//   co_await Behavior::AnimationDone(enemy);        // play-once animation
+//
+// BehaviorScheduler owns every running behavior. Delays sit in a min-heap
+// on the wake time and conditions sit on the BehaviorSignal they depend on,
+// so Advance() only touches behaviors whose timer is up and Notify() only
+// re-checks behaviors waiting on that signal. A sleeping behavior costs
+// nothing per frame.
+//
+// Behaviors are identified by BehaviorId; Cancel() destroys one, and a
+// behavior may cancel itself (e.g. by changing state), in which case it is
+// destroyed once it next suspends. Coroutine frames come from
+// BehaviorFramePool, so starting one doesn't hit the heap once the pool
+// has warmed up.
+//
+// Main thread only. Time only moves when the owner calls Advance(), so
+// pausing the game pauses every delay.
+
+#define BEHAVIOR_FRAME_GRANULE 64       // bytes per frame size class step
+#define BEHAVIOR_FRAME_CLASSES 8        // pooled frames go up to 512 bytes
+#define BEHAVIOR_FRAMES_PER_CHUNK 64
+
+typedef uint64_t BehaviorId;            // generation << 32 | slot
+#define BEHAVIOR_NONE 0ull
+
+class BehaviorFramePool {
+public:
+    static BehaviorFramePool* GetInstance() {
+        static BehaviorFramePool instance;
+        return &instance;
+    }
+
+    void* Allocate(size_t size) {
+        size_t size_class = (size + BEHAVIOR_FRAME_GRANULE - 1) / BEHAVIOR_FRAME_GRANULE - 1;
+        if (size_class >= BEHAVIOR_FRAME_CLASSES) {
+            heap_frames++;
+            return ::operator new(size);
+        }
+
+        if (free_lists[size_class] == nullptr) AddChunk(size_class);
+        FreeFrame* frame = free_lists[size_class];
+        free_lists[size_class] = frame->next;
+        live_frames++;
+        return frame;
+    }
+
+    void Free(void* memory, size_t size) {
+        size_t size_class = (size + BEHAVIOR_FRAME_GRANULE - 1) / BEHAVIOR_FRAME_GRANULE - 1;
+        if (size_class >= BEHAVIOR_FRAME_CLASSES) {
+            ::operator delete(memory);
+            return;
+        }
+
+        FreeFrame* frame = (FreeFrame*)memory;
+        frame->next = free_lists[size_class];
+        free_lists[size_class] = frame;
+        live_frames--;
+    }
+
+    void PrintStats() const {
+        std::cout << "Behavior frames: " << live_frames << " live, " << chunks.size() << " chunks pooled, "
+                  << heap_frames << " too big for the pool" << std::endl;
+    }
+
+private:
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    BehaviorFramePool() = default;
+
+    void AddChunk(size_t size_class) {
+        size_t frame_size = (size_class + 1) * BEHAVIOR_FRAME_GRANULE;
+        chunks.emplace_back(new char[frame_size * BEHAVIOR_FRAMES_PER_CHUNK]);
+        char* chunk = chunks.back().get();
+        for (int i = BEHAVIOR_FRAMES_PER_CHUNK - 1; i >= 0; i--) {
+            FreeFrame* frame = (FreeFrame*)(chunk + i * frame_size);
+            frame->next = free_lists[size_class];
+            free_lists[size_class] = frame;
+        }
+    }
+
+    FreeFrame* free_lists[BEHAVIOR_FRAME_CLASSES] = { nullptr };
+    std::vector<std::unique_ptr<char[]>> chunks;
+    size_t live_frames = 0;
+    size_t heap_frames = 0;
+};
+
+class BehaviorScheduler;
+
+// Something behaviors can wait on; whoever changes the state behind it
+// calls Notify()
+class BehaviorSignal {
+public:
+    void Notify();
+
+private:
+    friend class BehaviorScheduler;
+    std::vector<BehaviorId> waiters;
+};
+
+class Behavior {
+public:
+    struct promise_type {
+        BehaviorId id = BEHAVIOR_NONE;
+
+        static void* operator new(size_t size) {
+            return BehaviorFramePool::GetInstance()->Allocate(size);
+        }
+
+        static void operator delete(void* frame, size_t size) {
+            BehaviorFramePool::GetInstance()->Free(frame, size);
+        }
+
+        Behavior get_return_object() {
+            return Behavior(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Nothing runs until BehaviorScheduler::Start()
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct DelayAwaiter {
+        float seconds;
+        bool await_ready() const {
+            return seconds <= 0.0f;
+        }
+        void await_suspend(Handle handle);
+        void await_resume() {
+        }
+    };
+
+    struct ConditionAwaiter {
+        BehaviorSignal& signal;
+        std::function<bool()> condition;
+        bool await_ready() const {
+            return condition();
+        }
+        void await_suspend(Handle handle);
+        void await_resume() {
+        }
+    };
+
+    static DelayAwaiter Delay(float seconds) {
+        return { seconds };
+    }
+
+    // 'condition' is checked now and then only when 'signal' fires
+    static ConditionAwaiter Until(BehaviorSignal& signal, std::function<bool()> condition) {
+        return { signal, std::move(condition) };
+    }
+
+    // 'enemy' fires animation_done when a play-once animation reaches its
+    // last frame
+    template <typename Enemy>
+    static ConditionAwaiter AnimationDone(Enemy& enemy) {
+        return Until(enemy.animation_done, [&enemy]() {
+            return enemy.currentFrame >= enemy.animationStartFrame + enemy.maxFrames - 1;
+        });
+    }
+
+    Behavior(Behavior&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+
+    Behavior(const Behavior&) = delete;
+    void operator=(const Behavior&) = delete;
+
+    // Only a behavior that was never started still owns its frame
+    ~Behavior() {
+        if (handle) handle.destroy();
+    }
+
+private:
+    friend class BehaviorScheduler;
+
+    explicit Behavior(Handle handle) : handle(handle) {
+    }
+
+    Handle handle;
+};
+
+class BehaviorScheduler {
+public:
+    static BehaviorScheduler* GetInstance() {
+        static BehaviorScheduler instance;
+        return &instance;
+    }
+
+    // Runs the behavior up to its first wait; BEHAVIOR_NONE if it finished
+    // without waiting
+    BehaviorId Start(Behavior behavior) {
+        uint32_t index;
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            index = (uint32_t)slots.size();
+            slots.emplace_back();
+        }
+
+        Slot& slot = slots[index];
+        slot.handle = behavior.handle;
+        behavior.handle = nullptr;
+        slot.generation++;
+        slot.cancelled = false;
+        BehaviorId id = ((BehaviorId)slot.generation << 32) | index;
+        slot.handle.promise().id = id;
+
+        Resume(index);
+        return IsRunning(id) ? id : BEHAVIOR_NONE;
+    }
+
+    void Cancel(BehaviorId id) {
+        Slot* slot = Find(id);
+        if (slot == nullptr) return;
+        if (slot->state == SLOT_RUNNING) {
+            slot->cancelled = true;     // destroyed once it suspends
+        } else {
+            Destroy((uint32_t)(id & 0xffffffffu));
+        }
+    }
+
+    bool IsRunning(BehaviorId id) const {
+        uint32_t index = (uint32_t)(id & 0xffffffffu);
+        return id != BEHAVIOR_NONE && index < slots.size() && slots[index].generation == (uint32_t)(id >> 32) &&
+               slots[index].state != SLOT_FREE && !slots[index].cancelled;
+    }
+
+    // Seconds until a delayed behavior wakes, 0 if it isn't in a delay
+    float Remaining(BehaviorId id) const {
+        if (!IsRunning(id)) return 0.0f;
+        const Slot& slot = slots[id & 0xffffffffu];
+        if (slot.state != SLOT_SLEEPING) return 0.0f;
+        return slot.wake_time > now ? (float)(slot.wake_time - now) : 0.0f;
+    }
+
+    // Moves game time forward and wakes every behavior whose delay is up
+    void Advance(float delta_time) {
+        now += delta_time;
+        while (!timers.empty() && timers.top().time <= now) {
+            Timer timer = timers.top();
+            timers.pop();
+
+            Slot* slot = Find(timer.id);
+            if (slot == nullptr || slot->state != SLOT_SLEEPING || slot->wake_time != timer.time) continue;
+            Resume((uint32_t)(timer.id & 0xffffffffu));
+        }
+    }
+
+    size_t GetRunningCount() const {
+        return slots.size() - free_slots.size();
+    }
+
+private:
+    friend struct Behavior::DelayAwaiter;
+    friend struct Behavior::ConditionAwaiter;
+    friend class BehaviorSignal;
+
+    enum SlotState {
+        SLOT_FREE,
+        SLOT_RUNNING,
+        SLOT_SLEEPING,
+        SLOT_WAITING
+    };
+
+    struct Slot {
+        Behavior::Handle handle;
+        uint32_t generation = 0;
+        SlotState state = SLOT_FREE;
+        bool cancelled = false;
+        double wake_time = 0.0;
+        BehaviorSignal* signal = nullptr;
+        std::function<bool()> condition;
+    };
+
+    struct Timer {
+        double time;
+        BehaviorId id;
+        bool operator>(const Timer& other) const {
+            return time > other.time;
+        }
+    };
+
+    BehaviorScheduler() = default;
+
+    ~BehaviorScheduler() {
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].state != SLOT_FREE) Destroy(i);
+        }
+    }
+
+    Slot* Find(BehaviorId id) {
+        uint32_t index = (uint32_t)(id & 0xffffffffu);
+        if (id == BEHAVIOR_NONE || index >= slots.size()) return nullptr;
+        Slot& slot = slots[index];
+        if (slot.generation != (uint32_t)(id >> 32) || slot.state == SLOT_FREE) return nullptr;
+        return &slot;
+    }
+
+    void Sleep(BehaviorId id, float seconds) {
+        Slot& slot = slots[id & 0xffffffffu];
+        slot.state = SLOT_SLEEPING;
+        slot.wake_time = now + seconds;
+        timers.push({ slot.wake_time, id });
+    }
+
+    void Wait(BehaviorId id, BehaviorSignal& signal, std::function<bool()> condition) {
+        Slot& slot = slots[id & 0xffffffffu];
+        slot.state = SLOT_WAITING;
+        slot.signal = &signal;
+        slot.condition = std::move(condition);
+
+        // Drop waiters that were cancelled since the signal last fired
+        std::vector<BehaviorId>& waiters = signal.waiters;
+        size_t kept = 0;
+        for (BehaviorId waiter : waiters) {
+            if (Find(waiter) != nullptr) waiters[kept++] = waiter;
+        }
+        waiters.resize(kept);
+        waiters.push_back(id);
+    }
+
+    void Wake(BehaviorSignal& signal) {
+        std::vector<BehaviorId> waiting;
+        waiting.swap(signal.waiters);
+        for (BehaviorId id : waiting) {
+            Slot* slot = Find(id);
+            if (slot == nullptr || slot->state != SLOT_WAITING || slot->signal != &signal) continue;
+            if (slot->condition()) {
+                slot->signal = nullptr;
+                slot->condition = nullptr;
+                Resume((uint32_t)(id & 0xffffffffu));
+            } else {
+                signal.waiters.push_back(id);
+            }
+        }
+    }
+
+    void Resume(uint32_t index) {
+        slots[index].state = SLOT_RUNNING;
+        // Copy: the behavior may start others, which can grow 'slots'
+        Behavior::Handle handle = slots[index].handle;
+        handle.resume();
+        if (handle.done() || slots[index].cancelled) Destroy(index);
+    }
+
+    void Destroy(uint32_t index) {
+        Slot& slot = slots[index];
+        slot.handle.destroy();
+        slot.handle = nullptr;
+        slot.state = SLOT_FREE;
+        slot.cancelled = false;
+        slot.signal = nullptr;
+        slot.condition = nullptr;
+        free_slots.push_back(index);
+    }
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free_slots;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+    double now = 0.0;
+};
+
+inline void BehaviorSignal::Notify() {
+    if (!waiters.empty()) BehaviorScheduler::GetInstance()->Wake(*this);
+}
+
+inline void Behavior::DelayAwaiter::await_suspend(Handle handle) {
+    BehaviorScheduler::GetInstance()->Sleep(handle.promise().id, seconds);
+}
+
+inline void Behavior::ConditionAwaiter::await_suspend(Handle handle) {
+    BehaviorScheduler::GetInstance()->Wait(handle.promise().id, signal, std::move(condition));
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef CROWD_SEPARATION_HPP
+#define CROWD_SEPARATION_HPP
+
+#include <raylib.h>
+#include <raymath.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "EnemyBase.hpp"
+
+// Keeps enemies from stacking on top of each other.
+//
+// Once per frame, after every enemy has run its AI, Update() drops the live
+// enemies into a spatial hash and gives each one a push away from the
+// neighbours it overlaps. The Wandering and Chasing states add that push
+// (BaseEnemy::separation) to the velocity they compute on the next frame.
+//
+// The hash is rebuilt from scratch with a counting sort: count enemies per
+// bucket, prefix-sum the counts, then scatter enemy indices into one flat
+// array, so there is no per-cell allocation. Cells are as wide as the
+// largest enemy, which means overlapping enemies are always in the same or
+// adjacent cells and each enemy only looks at 9 buckets. The whole pass is
+// O(n) for a crowd spread over the map.
+
+#define CROWD_PUSH_SPEED 90.0f      // push at full overlap, world units per second
+#define CROWD_MAX_PUSH 120.0f
+
+class CrowdSeparation {
+public:
+    void Update(const std::vector<BaseEnemy*>& enemies) {
+        live.clear();
+        float largest_radius = 1.0f;
+        for (BaseEnemy* enemy : enemies) {
+            if (!enemy->active) continue;
+            live.push_back(enemy);
+            if (enemy->radius > largest_radius) largest_radius = enemy->radius;
+        }
+
+        int count = (int)live.size();
+        cell_size = largest_radius * 2.0f;
+
+        // Power-of-two table about twice the crowd size keeps buckets short
+        int table_size = 64;
+        while (table_size < count * 2) table_size *= 2;
+        mask = (uint32_t)table_size - 1;
+
+        cell_of.resize(count);
+        bucket_start.assign(table_size + 1, 0);
+        for (int i = 0; i < count; i++) {
+            cell_of[i] = Bucket(CellX(live[i]->position.x), CellY(live[i]->position.y));
+            bucket_start[cell_of[i] + 1]++;
+        }
+        for (int b = 0; b < table_size; b++) {
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        sorted.resize(count);
+        fill.assign(bucket_start.begin(), bucket_start.end() - 1);
+        for (int i = 0; i < count; i++) {
+            sorted[fill[cell_of[i]]++] = i;
+        }
+
+        pairs_checked = 0;
+        for (int i = 0; i < count; i++) {
+            BaseEnemy* enemy = live[i];
+            int cx = CellX(enemy->position.x);
+            int cy = CellY(enemy->position.y);
+            Vector2 push = { 0.0f, 0.0f };
+
+            uint32_t visited[9];
+            int visited_count = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    // Two neighbouring cells can hash to the same bucket
+                    uint32_t bucket = Bucket(cx + dx, cy + dy);
+                    bool seen = false;
+                    for (int v = 0; v < visited_count; v++) seen = seen || visited[v] == bucket;
+                    if (seen) continue;
+                    visited[visited_count++] = bucket;
+
+                    for (int k = bucket_start[bucket]; k < bucket_start[bucket + 1]; k++) {
+                        int j = sorted[k];
+                        if (j == i) continue;
+                        pairs_checked++;
+                        Push(enemy, live[j], i, push);
+                    }
+                }
+            }
+
+            float length = Vector2Length(push);
+            if (length > CROWD_MAX_PUSH) push = Vector2Scale(push, CROWD_MAX_PUSH / length);
+            enemy->separation = push;
+        }
+    }
+
+    // Neighbour tests done by the last Update(), for profiling
+    int GetPairsChecked() const {
+        return pairs_checked;
+    }
+
+private:
+    int CellX(float x) const {
+        return (int)floorf(x / cell_size);
+    }
+
+    int CellY(float y) const {
+        return (int)floorf(y / cell_size);
+    }
+
+    uint32_t Bucket(int cx, int cy) const {
+        return (((uint32_t)cx * 73856093u) ^ ((uint32_t)cy * 19349663u)) & mask;
+    }
+
+    static void Push(const BaseEnemy* enemy, const BaseEnemy* other, int index, Vector2& push) {
+        float reach = enemy->radius + other->radius;
+        Vector2 offset = Vector2Subtract(enemy->position, other->position);
+        float distance_squared = offset.x * offset.x + offset.y * offset.y;
+        if (distance_squared >= reach * reach) return;
+
+        float distance = sqrtf(distance_squared);
+        Vector2 away;
+        if (distance > 0.001f) {
+            away = Vector2Scale(offset, 1.0f / distance);
+        } else {
+            // Exactly stacked: spread by index so the pair doesn't move as one
+            float angle = index * 2.39996f;
+            away = { cosf(angle), sinf(angle) };
+        }
+        float overlap = 1.0f - distance / reach;
+        push = Vector2Add(push, Vector2Scale(away, overlap * CROWD_PUSH_SPEED));
+    }
+
+    std::vector<BaseEnemy*> live;
+    std::vector<uint32_t> cell_of;
+    std::vector<int> bucket_start;
+    std::vector<int> fill;
+    std::vector<int> sorted;
+    float cell_size = 32.0f;
+    uint32_t mask = 63;
+    int pairs_checked = 0;
+};
+
+#endif
@@ -3,6 +3,16 @@
 
 #include "Entity.hpp"
 #include "TileMap.hpp"
+#include "scene_manager.hpp"
+#include "Snapshot.hpp"
+#include "Behavior.hpp"
+
+// enemyID values, also the type tag in Level snapshots
+#define ENEMY_SLIME 0
+#define ENEMY_BEE 1
+#define ENEMY_GHOST 2
+
+#define ENEMY_RADIUS 15.0f      // every enemy type is this size
 
 class BaseEnemy : public Entity {
 public:
@@ -10,6 +20,7 @@ public:
 
     Vector2 velocity;
     Vector2 acceleration;
+    Vector2 separation = { 0, 0 };     // crowd push, see CrowdSeparation
     float speed = 0.0f;
     bool active = true;
     Color color;
@@ -19,6 +30,7 @@ public:
     int currentFrame = 0;
     int maxFrames = 1;
     Texture2D sprite;
+    ResourceHandle sprite_handle;
     float frameWidth;
     float frameHeight;
 
@@ -26,18 +38,105 @@ public:
     float aggro_radius;
     float ready_attack_radius;
 
-    TileMap* tile_map;
+    TileMap* tile_map = nullptr;
     Entity* entity_following;
 
+    BehaviorId behavior = BEHAVIOR_NONE;    // the current state's coroutine, see Behavior.hpp
+    BehaviorSignal animation_done;          // a play-once animation reached its last frame
+
     void setTileMap(TileMap* map) {
         tile_map = map;
     }
 
+    // Line of sight to the player, read off the fog of war: the player can
+    // see this enemy's tile exactly when this enemy can see the player
+    bool CanSeePlayer() const {
+        return tile_map == nullptr || tile_map->fog.IsVisible(position);
+    }
+
+    // Exact line of sight to any point, for deciding whether an attack has
+    // a clear path
+    bool HasLineOfSight(Vector2 target) const {
+        return tile_map == nullptr || tile_map->HasLineOfSight(position, target);
+    }
+
+    // Replaces whatever the current state had running
+    void RunBehavior(Behavior new_behavior) {
+        StopBehavior();
+        behavior = BehaviorScheduler::GetInstance()->Start(std::move(new_behavior));
+    }
+
+    void StopBehavior() {
+        BehaviorScheduler::GetInstance()->Cancel(behavior);
+        behavior = BEHAVIOR_NONE;
+    }
+
+    // Seconds left on the behavior's current delay
+    float BehaviorRemaining() const {
+        return BehaviorScheduler::GetInstance()->Remaining(behavior);
+    }
+
+    static Vector2 RandomDirection() {
+        Vector2 direction = { GetRandomValue(-100, 100) / 100.0f, GetRandomValue(-100, 100) / 100.0f };
+        return Vector2Normalize(direction);
+    }
+
+    // Wandering: a new direction every 1-3 seconds, the first after
+    // 'first_turn'
+    static Behavior WanderTurns(Vector2& move_direction, float first_turn) {
+        float wait = first_turn;
+        while (true) {
+            co_await Behavior::Delay(wait);
+            move_direction = RandomDirection();
+            wait = (float)GetRandomValue(1, 3);
+        }
+    }
+
     virtual void Update(float delta_time) = 0;
     virtual void Draw() = 0;
     virtual void HandleCollision(Entity* other_entity) = 0;
 
-    virtual ~BaseEnemy() {}
+    // 'player' is what entity_following pointed at when the snapshot was taken
+    virtual void WriteSnapshot(SnapshotWriter& writer) = 0;
+    virtual void ReadSnapshot(SnapshotReader& reader, Entity* player) = 0;
+
+    // Fields every enemy shares; each enemy's Snapshot() starts with this
+    template <typename Archive>
+    void SnapshotBase(Archive& archive, Entity* player) {
+        archive.Value(health);
+        archive.Value(maxHealth);
+        archive.Value(position);
+        archive.Value(radius);
+        archive.Value(Entity::color);
+        archive.Value(invulnerable_timer);
+
+        archive.Value(velocity);
+        archive.Value(acceleration);
+        archive.Value(speed);
+        archive.Value(active);
+        archive.Value(color);
+        archive.Value(direction);
+        archive.Value(animationTimer);
+        archive.Value(frameSpeed);
+        archive.Value(currentFrame);
+        archive.Value(maxFrames);
+        archive.Value(detection_radius);
+        archive.Value(aggro_radius);
+        archive.Value(ready_attack_radius);
+
+        bool following = entity_following != nullptr;
+        archive.Value(following);
+        if (Archive::reading) entity_following = following ? player : nullptr;
+    }
+
+    BaseEnemy() = default;
+    BaseEnemy(const BaseEnemy&) = delete;
+    void operator=(const BaseEnemy&) = delete;
+
+    virtual ~BaseEnemy() {
+        StopBehavior();
+        ResourceManager::GetInstance()->Release(sprite_handle);
+    }
 };
 
 #endif
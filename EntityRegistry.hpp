@@ -0,0 +1,82 @@
+#ifndef ENTITY_REGISTRY_HPP
+#define ENTITY_REGISTRY_HPP
+
+#include <functional>
+#include <vector>
+
+// Live and killed counts per enemy type, kept up to date as enemies spawn
+// and die, so asking "is the wave cleared?" or "how many are left?" is O(1)
+// instead of a walk over every enemy.
+//
+// The scene owning the enemies reports each spawn and death exactly once;
+// a death also runs the death hooks, which is where per-kill effects go.
+// Types are the enemyID values (ENEMY_SLIME, ENEMY_BEE, ENEMY_GHOST).
+
+#define ENTITY_TYPE_COUNT 3
+
+template <typename Entity>
+class EntityRegistry {
+public:
+    using DeathHook = std::function<void(Entity&)>;
+
+    void AddDeathHook(DeathHook hook) {
+        death_hooks.push_back(std::move(hook));
+    }
+
+    void OnSpawn(int type) {
+        if (!ValidType(type)) return;
+        live[type]++;
+        live_total++;
+    }
+
+    void OnDeath(Entity& entity, int type) {
+        if (!ValidType(type) || live[type] == 0) return;
+        live[type]--;
+        live_total--;
+        kills[type]++;
+        kills_total++;
+        for (auto& hook : death_hooks) hook(entity);
+    }
+
+    // Everything alive went away without dying, e.g. a wave was replaced
+    void ClearLive() {
+        for (int type = 0; type < ENTITY_TYPE_COUNT; type++) live[type] = 0;
+        live_total = 0;
+    }
+
+    // New run: forgets the kills as well
+    void Reset() {
+        ClearLive();
+        for (int type = 0; type < ENTITY_TYPE_COUNT; type++) kills[type] = 0;
+        kills_total = 0;
+    }
+
+    int GetLiveCount() const {
+        return live_total;
+    }
+
+    int GetLiveCount(int type) const {
+        return ValidType(type) ? live[type] : 0;
+    }
+
+    int GetKills() const {
+        return kills_total;
+    }
+
+    int GetKills(int type) const {
+        return ValidType(type) ? kills[type] : 0;
+    }
+
+private:
+    static bool ValidType(int type) {
+        return type >= 0 && type < ENTITY_TYPE_COUNT;
+    }
+
+    int live[ENTITY_TYPE_COUNT] = { 0 };
+    int kills[ENTITY_TYPE_COUNT] = { 0 };
+    int live_total = 0;
+    int kills_total = 0;
+    std::vector<DeathHook> death_hooks;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef FOG_OF_WAR_HPP
+#define FOG_OF_WAR_HPP
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Fog of war over a tile grid: which tiles the player can see right now and
+// which they have ever seen, one bit per tile each.
+//
+// Visibility is recomputed with recursive shadowcasting from the player's
+// tile, and only when the player steps onto a different tile. The previous
+// visible tiles are kept in a list, so clearing them and casting the new
+// ones costs O(radius^2) no matter how big the map is. The overlay is one
+// texture with a texel per tile; only the rectangle covering the old and
+// new visible areas is re-uploaded. Shadowcasting is symmetric enough that
+// "the player sees tile T" doubles as "something standing on T sees the
+// player", which is what enemies use for line of sight.
+
+#define FOG_RADIUS 10               // tiles
+#define FOG_EXPLORED_ALPHA 160      // remembered but not in view
+#define FOG_HIDDEN_ALPHA 255        // never seen
+
+class FogOfWar {
+public:
+    // 'opaque' holds width*height bytes, row-major, nonzero for tiles that
+    // block sight; it must outlive the fog. Forgets everything explored.
+    // The overlay texture is only created once a window exists.
+    void Reset(const unsigned char* opaque, int width, int height, float tile_size, int radius = FOG_RADIUS) {
+        this->opaque = opaque;
+        this->width = width;
+        this->height = height;
+        this->tile_size = tile_size;
+        this->radius = radius;
+
+        int words = (width * height + 63) / 64;
+        visible.assign(words, 0);
+        explored.assign(words, 0);
+        lit.clear();
+        origin_x = origin_y = -1;
+
+        pixels.assign(width * height, Color{ 0, 0, 0, FOG_HIDDEN_ALPHA });
+        if (overlay.id != 0 && (overlay.width != width || overlay.height != height)) Unload();
+        if (overlay.id == 0 && IsWindowReady()) {
+            Image image = { pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+            overlay = LoadTextureFromImage(image);
+            SetTextureFilter(overlay, TEXTURE_FILTER_BILINEAR);
+        }
+        MarkAllDirty();
+    }
+
+    void Unload() {
+        if (overlay.id == 0) return;
+
+        UnloadTexture(overlay);
+        overlay = { 0 };
+        std::cout << "Fog: " << recasts << " recasts, " << uploaded_texels << " overlay texels uploaded" << std::endl;
+        recasts = 0;
+        uploaded_texels = 0;
+    }
+
+    // Recasts from the tile under 'position' if it changed since last time
+    void Update(Vector2 position) {
+        int x = (int)floorf(position.x / tile_size);
+        int y = (int)floorf(position.y / tile_size);
+        if (x == origin_x && y == origin_y) return;
+        origin_x = x;
+        origin_y = y;
+
+        Darken();
+
+        if (InBounds(x, y)) {
+            Light(x, y);
+            for (int octant = 0; octant < 8; octant++) {
+                CastLight(1, 1.0f, 0.0f, OCTANTS[octant]);
+            }
+        }
+        recasts++;
+    }
+
+    bool IsVisible(int x, int y) const {
+        return InBounds(x, y) && Bit(visible, y * width + x);
+    }
+
+    bool IsVisible(Vector2 position) const {
+        return IsVisible((int)floorf(position.x / tile_size), (int)floorf(position.y / tile_size));
+    }
+
+    bool IsExplored(int x, int y) const {
+        return InBounds(x, y) && Bit(explored, y * width + x);
+    }
+
+    int GetVisibleCount() const {
+        return (int)lit.size();
+    }
+
+    int GetRecasts() const {
+        return recasts;
+    }
+
+    const std::vector<uint64_t>& GetExplored() const {
+        return explored;
+    }
+
+    // Restores explored bits saved from a map of the same size
+    void SetExplored(std::vector<uint64_t> bits) {
+        if (bits.size() != explored.size()) return;
+        Darken();
+        explored = std::move(bits);
+        for (int index = 0; index < width * height; index++) {
+            pixels[index].a = Bit(explored, index) ? FOG_EXPLORED_ALPHA : FOG_HIDDEN_ALPHA;
+        }
+        origin_x = origin_y = -1;   // recast on the next Update()
+        MarkAllDirty();
+    }
+
+    // Draws the overlay in world space, inside the camera
+    void Draw() {
+        if (overlay.id == 0) return;
+
+        if (dirty_right >= dirty_left) {
+            int w = dirty_right - dirty_left + 1;
+            int h = dirty_bottom - dirty_top + 1;
+            upload.resize(w * h);
+            for (int row = 0; row < h; row++) {
+                const Color* source = &pixels[(dirty_top + row) * width + dirty_left];
+                std::copy(source, source + w, &upload[row * w]);
+            }
+            UpdateTextureRec(overlay, { (float)dirty_left, (float)dirty_top, (float)w, (float)h }, upload.data());
+            uploaded_texels += w * h;
+            ClearDirty();
+        }
+
+        DrawTexturePro(overlay, { 0, 0, (float)width, (float)height },
+                       { 0, 0, width * tile_size, height * tile_size }, { 0, 0 }, 0.0f, WHITE);
+    }
+
+    long long GetUploadedTexels() const {
+        return uploaded_texels;
+    }
+
+private:
+    struct Octant {
+        int xx, xy, yx, yy;
+    };
+
+    static constexpr Octant OCTANTS[8] = {
+        { 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+        { -1, 0, 0, -1 }, { 0, -1, -1, 0 }, { 0, 1, -1, 0 }, { 1, 0, 0, -1 },
+    };
+
+    static bool Bit(const std::vector<uint64_t>& bits, int index) {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    bool InBounds(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    bool Opaque(int x, int y) const {
+        return !InBounds(x, y) || opaque[y * width + x] != 0;
+    }
+
+    // Moves every visible tile back to merely explored
+    void Darken() {
+        for (int index : lit) {
+            visible[index >> 6] &= ~(1ull << (index & 63));
+            pixels[index].a = FOG_EXPLORED_ALPHA;
+            AddDirty(index % width, index / width);
+        }
+        lit.clear();
+    }
+
+    void Light(int x, int y) {
+        int index = y * width + x;
+        uint64_t mask = 1ull << (index & 63);
+        if (visible[index >> 6] & mask) return;
+
+        visible[index >> 6] |= mask;
+        explored[index >> 6] |= mask;
+        lit.push_back(index);
+        pixels[index].a = 0;
+        AddDirty(x, y);
+    }
+
+    // Björn Bergström's recursive shadowcasting over one octant. Rows run
+    // outward from the origin; 'start' and 'end' are the slopes still lit.
+    void CastLight(int row, float start, float end, const Octant& octant) {
+        if (start < end) return;
+
+        float next_start = start;
+        for (int distance = row; distance <= radius; distance++) {
+            bool blocked = false;
+            int dy = -distance;
+            for (int dx = -distance; dx <= 0; dx++) {
+                float left_slope = (dx - 0.5f) / (dy + 0.5f);
+                float right_slope = (dx + 0.5f) / (dy - 0.5f);
+                if (start < right_slope) continue;
+                if (end > left_slope) break;
+
+                int x = origin_x + dx * octant.xx + dy * octant.xy;
+                int y = origin_y + dx * octant.yx + dy * octant.yy;
+                if (InBounds(x, y) && dx * dx + dy * dy <= radius * radius) Light(x, y);
+
+                bool wall = Opaque(x, y);
+                if (blocked) {
+                    if (wall) {
+                        next_start = right_slope;
+                    } else {
+                        blocked = false;
+                        start = next_start;
+                    }
+                } else if (wall && distance < radius) {
+                    blocked = true;
+                    CastLight(distance + 1, start, left_slope, octant);
+                    next_start = right_slope;
+                }
+            }
+            if (blocked) break;
+        }
+    }
+
+    void AddDirty(int x, int y) {
+        if (x < dirty_left) dirty_left = x;
+        if (x > dirty_right) dirty_right = x;
+        if (y < dirty_top) dirty_top = y;
+        if (y > dirty_bottom) dirty_bottom = y;
+    }
+
+    void ClearDirty() {
+        dirty_left = width;
+        dirty_top = height;
+        dirty_right = -1;
+        dirty_bottom = -1;
+    }
+
+    void MarkAllDirty() {
+        dirty_left = 0;
+        dirty_top = 0;
+        dirty_right = width - 1;
+        dirty_bottom = height - 1;
+    }
+
+    const unsigned char* opaque = nullptr;
+    int width = 0;
+    int height = 0;
+    float tile_size = 16.0f;
+    int radius = FOG_RADIUS;
+
+    std::vector<uint64_t> visible;
+    std::vector<uint64_t> explored;
+    std::vector<int> lit;               // indices of the visible tiles
+    int origin_x = -1;
+    int origin_y = -1;
+
+    Texture2D overlay = { 0 };
+    std::vector<Color> pixels;          // overlay contents, one per tile
+    std::vector<Color> upload;
+    int dirty_left = 0;                 // nothing to upload when right < left
+    int dirty_top = 0;
+    int dirty_right = -1;
+    int dirty_bottom = -1;
+
+    int recasts = 0;
+    long long uploaded_texels = 0;
+};
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "InputSystem.hpp"
+
+// Replaces SetTargetFPS(). raylib waits after the buffer swap for "target
+// minus how long this frame took", so the swap itself lands whenever the
+// frame's work happens to finish and every oversleep shifts later frames.
+// Here frames are due on a fixed grid of deadlines and the wait sits right
+// before the swap: BeforePresent() flushes the batch, sleeps until a margin
+// before the deadline and spins the rest, then EndDrawing() swaps on time.
+// Missing a deadline only moves the grid when a whole frame was lost.
+//
+// The spin margin follows the worst recent oversleep, so on a box whose
+// sleep wakes late the spin covers it, and on one that wakes on time hardly
+// any CPU is burned.
+//
+// Late input: waiting before the swap means input sampled at the top of the
+// frame is a whole frame old by the time it shows. With late input on,
+// BeginFrame() also sleeps until the deadline minus the recent worst frame
+// cost, then raylib polls the input again (InputSystem::Repoll()), so the
+// simulation runs on input from just before it starts and still makes the
+// deadline. With vsync the deadline is one period after the last swap.
+//
+// Every present-to-present interval goes into a ring, which gives the mean,
+// the standard deviation and the 1% low (the 99th percentile frame time).
+
+enum PresentMode {
+    PRESENT_VSYNC,      // the driver blocks in the buffer swap
+    PRESENT_CAPPED,     // sleep-then-spin to the target frame rate
+    PRESENT_UNCAPPED
+};
+
+#define FRAME_PACER_HISTORY 600                 // intervals kept, 10 s at 60 FPS
+#define FRAME_PACER_MIN_MARGIN 0.0005           // seconds always left to spin
+#define FRAME_PACER_MAX_MARGIN 0.004
+#define FRAME_PACER_DECAY 0.995                 // per frame, for the margin and frame cost
+#define FRAME_PACER_COST_SLACK 0.001            // seconds added to the frame cost for late input
+
+struct FramePacingStats {
+    double mean_ms = 0.0;
+    double deviation_ms = 0.0;
+    double one_percent_low_ms = 0.0;
+    int samples = 0;
+};
+
+class FramePacer {
+public:
+    static FramePacer* GetInstance() {
+        static FramePacer instance;
+        return &instance;
+    }
+
+    // After InitWindow(); replaces SetTargetFPS()
+    void Configure(PresentMode mode, double target_fps, bool late_input) {
+        this->mode = mode;
+        this->late_input = late_input;
+        period = Seconds(1.0 / target_fps);
+
+        SetTargetFPS(0);
+        if (mode == PRESENT_VSYNC) {
+            SetWindowState(FLAG_VSYNC_HINT);
+        } else if (IsWindowState(FLAG_VSYNC_HINT)) {
+            ClearWindowState(FLAG_VSYNC_HINT);
+        }
+        deadline = Clock::now() + period;
+        margin = FRAME_PACER_MIN_MARGIN;
+        frame_cost = 0.0;
+        intervals.clear();
+        next_interval = 0;
+        last_present = Clock::time_point();
+    }
+
+    // Top of the main loop, before input is sampled
+    void BeginFrame() {
+        if (late_input && mode != PRESENT_UNCAPPED) {
+            Clock::time_point due = mode == PRESENT_VSYNC ? last_present + period : deadline;
+            WaitUntil(due - Seconds(frame_cost + FRAME_PACER_COST_SLACK));
+            InputSystem::GetInstance()->Repoll();
+        }
+        frame_start = Clock::now();
+    }
+
+    // After the scene has drawn, right before EndDrawing()
+    void BeforePresent() {
+        Clock::time_point now = Clock::now();
+        double cost = std::chrono::duration<double>(now - frame_start).count();
+        frame_cost = std::max(frame_cost * FRAME_PACER_DECAY, cost);
+        if (mode != PRESENT_CAPPED) return;
+
+        rlDrawRenderBatchActive();      // hand the GPU its work before sleeping
+        if (now - deadline > period) deadline = now;    // lost a frame: new grid
+        WaitUntil(deadline);
+        deadline += period;
+    }
+
+    // Right after EndDrawing(). Frames that blocked waiting for events
+    // aren't paced, so the interval ending on one isn't counted.
+    void OnPresent(bool idle = false) {
+        Clock::time_point now = Clock::now();
+        if (!idle && last_present != Clock::time_point()) {
+            double interval = std::chrono::duration<double, std::milli>(now - last_present).count();
+            if ((int)intervals.size() < FRAME_PACER_HISTORY) {
+                intervals.push_back(interval);
+            } else {
+                intervals[next_interval] = interval;
+            }
+            next_interval = (next_interval + 1) % FRAME_PACER_HISTORY;
+        }
+        last_present = now;
+    }
+
+    FramePacingStats GetStats() {
+        FramePacingStats stats;
+        stats.samples = (int)intervals.size();
+        if (stats.samples == 0) return stats;
+
+        double sum = 0.0, sum_squares = 0.0;
+        for (double interval : intervals) {
+            sum += interval;
+            sum_squares += interval * interval;
+        }
+        stats.mean_ms = sum / stats.samples;
+        stats.deviation_ms = sqrt(std::max(0.0, sum_squares / stats.samples - stats.mean_ms * stats.mean_ms));
+
+        sorted = intervals;
+        size_t slowest = (size_t)(sorted.size() * 0.99);
+        if (slowest >= sorted.size()) slowest = sorted.size() - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + slowest, sorted.end());
+        stats.one_percent_low_ms = sorted[slowest];
+        return stats;
+    }
+
+    static const char* ModeName(PresentMode mode) {
+        switch (mode) {
+            case PRESENT_VSYNC: return "vsync";
+            case PRESENT_UNCAPPED: return "uncapped";
+            default: return "capped";
+        }
+    }
+
+    void PrintStats() {
+        FramePacingStats stats = GetStats();
+        if (stats.samples == 0) return;
+        std::cout << "Frame pacing (" << ModeName(mode) << (late_input ? ", late input" : "") << "): "
+                  << stats.mean_ms << " ms mean, " << stats.deviation_ms << " ms deviation, 1% low "
+                  << stats.one_percent_low_ms << " ms over the last " << stats.samples << " frames" << std::endl;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer() = default;
+
+    static Clock::duration Seconds(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    // Sleeps until 'margin' before 'until', then spins
+    void WaitUntil(Clock::time_point until) {
+        Clock::time_point wake = until - Seconds(margin);
+        if (Clock::now() < wake) {
+            std::this_thread::sleep_until(wake);
+            double oversleep = std::chrono::duration<double>(Clock::now() - wake).count();
+            margin = std::max(margin * FRAME_PACER_DECAY, oversleep * 1.25);
+            margin = std::min(std::max(margin, FRAME_PACER_MIN_MARGIN), FRAME_PACER_MAX_MARGIN);
+        }
+        while (Clock::now() < until) {
+        }
+    }
+
+    PresentMode mode = PRESENT_CAPPED;
+    bool late_input = false;
+    Clock::duration period = std::chrono::microseconds(16667);
+    Clock::time_point deadline;
+    Clock::time_point frame_start;
+    double margin = FRAME_PACER_MIN_MARGIN;
+    double frame_cost = 0.0;            // recent worst BeginFrame() to BeforePresent()
+
+    Clock::time_point last_present;
+    std::vector<double> intervals;
+    std::vector<double> sorted;
+    int next_interval = 0;
+};
+
+#endif
@@ -21,7 +21,6 @@ public:
 
 class GhostWandering: public GhostState {
 public: 
-    float change_direction_cooldown;
     Vector2 move_direction;
     void Enter (Ghost& ghost);
     void Update(Ghost& ghost, float delta_time);
@@ -59,8 +58,9 @@ public:
     Rectangle ghostDR;
 
     int animationStartFrame;
-    float hideTimer;
+    float hideTimer;    // wandering time left before hiding, banked while not wandering
     bool playOnce; 
+    BehaviorId hide_behavior = BEHAVIOR_NONE;
 
 
     GhostWandering wandering;
@@ -78,6 +78,16 @@ public:
     void SetState(GhostState* new_state);
     void HandleCollision(Entity* other_entity) override;
 
+    void WriteSnapshot(SnapshotWriter& writer) override;
+    void ReadSnapshot(SnapshotReader& reader, Entity* player) override;
+
+    template <typename Archive>
+    void Snapshot(Archive& archive, Entity* player);
+
+    ~Ghost();
+    static Behavior Hide(Ghost& ghost);
+    void PauseHide();
+
 private:
     GhostState* current_state;
     bool flash_visible;
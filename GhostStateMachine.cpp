@@ -76,6 +76,8 @@ void Ghost::Draw() {
 }
 
 void Ghost::SetState(GhostState* new_state) {
+    StopBehavior();
+    PauseHide();
     current_state = new_state;
     current_state->Enter(*this);
 }
@@ -85,7 +87,7 @@ void Ghost::HandleCollision(Entity* other_entity) {
 }
 
 Ghost::Ghost(Vector2 pos, float spd, float rad, float d_radius, float a_radius, float r_radius, int hp) {
-    enemyID = 2;
+    enemyID = ENEMY_GHOST;
     position = pos;
     speed = spd;
     radius = rad;
@@ -100,7 +102,10 @@ Ghost::Ghost(Vector2 pos, float spd, float rad, float d_radius, float a_radius,
     flash_timer = 0.0f;
     flash_interval = 0.1f;
 
-    sprite = LoadTexture(GAME_SCENE_SPRITE_GHOST);
+    static ResourceHandle shared_sprite;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    sprite_handle = resources->AcquireShared(shared_sprite, GAME_SCENE_SPRITE_GHOST, ResourceType::TEXTURE);
+    sprite = resources->GetTexture(sprite_handle).texture;
     frameWidth = sprite.width / 6;
     frameHeight = sprite.height / 4;
     currentFrame = 0;
@@ -115,14 +120,34 @@ Ghost::Ghost(Vector2 pos, float spd, float rad, float d_radius, float a_radius,
 
 }
 
+Ghost::~Ghost() {
+    BehaviorScheduler::GetInstance()->Cancel(hide_behavior);
+}
+
+// Only counts down while wandering
+Behavior Ghost::Hide(Ghost& ghost) {
+    co_await Behavior::Delay(ghost.hideTimer);
+    ghost.hideTimer = 0.0f;
+    ghost.animationStartFrame = 3;
+    ghost.maxFrames = 1;
+    ghost.currentFrame = 3;
+}
+
+void Ghost::PauseHide() {
+    BehaviorScheduler* behaviors = BehaviorScheduler::GetInstance();
+    if (!behaviors->IsRunning(hide_behavior)) return;
+    hideTimer = behaviors->Remaining(hide_behavior);
+    behaviors->Cancel(hide_behavior);
+    hide_behavior = BEHAVIOR_NONE;
+}
+
 void GhostWandering::Enter(Ghost& ghost) {
     ghost.playOnce = false;
     ghost.color = VIOLET;
     ghost.speed = 5.0f;
-    change_direction_cooldown = GetRandomValue(1, 3);
-    move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-    move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-    move_direction = Vector2Normalize(move_direction);
+    float first_turn = GetRandomValue(1, 3);
+    move_direction = BaseEnemy::RandomDirection();
+    ghost.RunBehavior(BaseEnemy::WanderTurns(move_direction, first_turn));
     ghost.entity_following = nullptr;
 
     if (ghost.hideTimer <= 0.0f) {
@@ -135,6 +160,10 @@ void GhostWandering::Enter(Ghost& ghost) {
 
     ghost.currentFrame = ghost.animationStartFrame;
     ghost.frameSpeed = 0.15f;
+
+    if (ghost.hideTimer > 0.0f) {
+        ghost.hide_behavior = BehaviorScheduler::GetInstance()->Start(Ghost::Hide(ghost));
+    }
 }
 
 
@@ -153,33 +182,6 @@ void GhostAttacking::Enter(Ghost& ghost) {
 }
 
 void GhostWandering::Update(Ghost& ghost, float delta_time) {
-    ghost.velocity = Vector2Zero();
-
-    // Update hide timer
-    if (ghost.hideTimer > 0.0f) {
-        ghost.hideTimer -= delta_time;
-    }
-
-
-    if (ghost.hideTimer <= 0.0f && ghost.animationStartFrame != 4) {
-        ghost.animationStartFrame = 3;
-        ghost.maxFrames = 1;
-        ghost.currentFrame = 3;
-    } else if (ghost.hideTimer > 0.0f && ghost.animationStartFrame != 0) {
-        ghost.animationStartFrame = 0;
-        ghost.maxFrames = 3;
-        ghost.currentFrame = 0;
-    }
-
-    if (change_direction_cooldown <= 0.0f) {
-        move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-        move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-        move_direction = Vector2Normalize(move_direction);
-        change_direction_cooldown = GetRandomValue(1, 3);
-    } else {
-        change_direction_cooldown -= delta_time;
-    }
-
     ghost.velocity = Vector2Scale(move_direction, 50.0f);
 
     // Direction
@@ -189,16 +191,18 @@ void GhostWandering::Update(Ghost& ghost, float delta_time) {
         ghost.direction = ghost.velocity.y < 0 ? 0 : 2;
     }
 
+    ghost.velocity = Vector2Add(ghost.velocity, ghost.separation);
+
     Vector2 new_position = Vector2Add(ghost.position, Vector2Scale(ghost.velocity, delta_time));
 
-    Ghost temp_ghost = ghost;
+    Entity temp_ghost = ghost;
     temp_ghost.position = new_position;
 
     if (ghost.tile_map && !ghost.tile_map->CheckTileCollision(&temp_ghost)) {
         ghost.position = new_position;
     } else {
-        move_direction = Vector2Normalize({GetRandomValue(-100, 100) / 100.0f, GetRandomValue(-100, 100) / 100.0f});
-        change_direction_cooldown = GetRandomValue(1, 3);
+        move_direction = BaseEnemy::RandomDirection();
+        ghost.RunBehavior(BaseEnemy::WanderTurns(move_direction, GetRandomValue(1, 3)));
     }
 
     if (ghost.invulnerable_timer > 0.0f) {
@@ -231,9 +235,11 @@ void GhostChasing::Update(Ghost& ghost, float delta_time) {
         }
     }
 
+    ghost.velocity = Vector2Add(ghost.velocity, ghost.separation);
+
     Vector2 new_position = Vector2Add(ghost.position, Vector2Scale(ghost.velocity, delta_time));
 
-    Ghost temp_enemy = ghost;
+    Entity temp_enemy = ghost;
     temp_enemy.position = new_position;
 
     if(ghost.tile_map && !ghost.tile_map->CheckTileCollision(&temp_enemy)) {
@@ -264,7 +270,7 @@ void GhostAttacking::Update(Ghost& ghost, float delta_time) {
 }
 
 void GhostWandering::HandleCollision(Ghost& ghost, Entity* other_entity) {
-    if (CheckCollisionCircles(ghost.position, ghost.detection_radius, other_entity->position, other_entity->radius)) {
+    if (CheckCollisionCircles(ghost.position, ghost.detection_radius, other_entity->position, other_entity->radius) && ghost.CanSeePlayer()) {
         ghost.entity_following = other_entity;
         ghost.SetState(&ghost.chasing);
     }
@@ -275,7 +281,8 @@ void GhostChasing::HandleCollision(Ghost& ghost, Entity* other_entity) {
         ghost.SetState(&ghost.wandering);
     }
 
-    if(CheckCollisionCircles(ghost.position, ghost.ready_attack_radius, other_entity->position, other_entity->radius)) {
+    if(CheckCollisionCircles(ghost.position, ghost.ready_attack_radius, other_entity->position, other_entity->radius) &&
+       ghost.HasLineOfSight(other_entity->position)) {
         ghost.SetState(&ghost.attack);
     }
 }
@@ -284,4 +291,50 @@ void GhostAttacking::HandleCollision(Ghost& ghost, Entity* other_entity) {
     if (!CheckCollisionCircles(ghost.position, ghost.ready_attack_radius, other_entity->position, other_entity->radius)) {
         ghost.SetState(&ghost.chasing);
     }
-}
\ No newline at end of file
+}
+
+template <typename Archive>
+void Ghost::Snapshot(Archive& archive, Entity* player) {
+    SnapshotBase(archive, player);
+
+    GhostState* states[] = { &wandering, &chasing, &attack };
+    int state = 0;
+    for (int i = 0; i < 3; i++) {
+        if (current_state == states[i]) state = i;
+    }
+    archive.Value(state);
+    if (Archive::reading) current_state = states[(state >= 0 && state < 3) ? state : 0];
+
+    // The coroutines' frames aren't saved, only how long their delays had left
+    float change_direction_cooldown = current_state == &wandering ? BehaviorRemaining() : 0.0f;
+    if (!Archive::reading && BehaviorScheduler::GetInstance()->IsRunning(hide_behavior)) {
+        hideTimer = BehaviorScheduler::GetInstance()->Remaining(hide_behavior);
+    }
+    archive.Value(change_direction_cooldown);
+    archive.Value(wandering.move_direction);
+    archive.Value(animation_state);
+    archive.Value(animationStartFrame);
+    archive.Value(hideTimer);
+    archive.Value(playOnce);
+    archive.Value(flash_visible);
+    archive.Value(flash_timer);
+    archive.Value(flash_interval);
+
+    if (Archive::reading) {
+        StopBehavior();
+        BehaviorScheduler::GetInstance()->Cancel(hide_behavior);
+        hide_behavior = BEHAVIOR_NONE;
+        if (current_state == &wandering) {
+            RunBehavior(BaseEnemy::WanderTurns(wandering.move_direction, change_direction_cooldown));
+            if (hideTimer > 0.0f) hide_behavior = BehaviorScheduler::GetInstance()->Start(Hide(*this));
+        }
+    }
+}
+
+void Ghost::WriteSnapshot(SnapshotWriter& writer) {
+    Snapshot(writer, nullptr);
+}
+
+void Ghost::ReadSnapshot(SnapshotReader& reader, Entity* player) {
+    Snapshot(reader, player);
+}
@@ -0,0 +1,274 @@
+#ifndef INPUT_SYSTEM_HPP
+#define INPUT_SYSTEM_HPP
+
+#include <raylib.h>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Game input as actions instead of raw keys. Sample() reads every binding
+// once at the start of the frame into a snapshot of three action bitsets
+// (down, pressed this frame, released this frame); gameplay code reads the
+// snapshot and never asks raylib directly, so a key is looked up once per
+// frame no matter how many states care about it.
+//
+// Bindings start at the defaults below and can be changed with Bind() or
+// from INPUT_BINDINGS_FILE, one action per line:
+//
+//   attack key 32 mouse 0
+//
+// raylib only hands over input when it polls events at the end of
+// EndDrawing(), so that poll is the finest timestamp there is: every edge
+// is stamped with the poll that delivered it. OnPresent() runs right after
+// EndDrawing() and measures, for frames that reacted to a press, the time
+// from that poll to the frame being presented.
+//
+// Repoll() polls a second time just before Sample() (FramePacer does this
+// for late input). A poll forgets the previous poll's press and release
+// edges, and menus still read raylib directly, so Repoll() skips the poll
+// whenever the last one delivered any key or mouse button edge at all.
+// Nothing is lost that way; input that arrives during the wait is still
+// picked up by the next regular poll.
+
+enum InputAction {
+    ACTION_MOVE_UP,
+    ACTION_MOVE_DOWN,
+    ACTION_MOVE_LEFT,
+    ACTION_MOVE_RIGHT,
+    ACTION_ATTACK,
+    ACTION_BLOCK,
+    ACTION_DODGE,
+    ACTION_PAUSE,
+    ACTION_OVERLAY,
+    ACTION_COUNT
+};
+
+enum InputDevice {
+    INPUT_NONE,
+    INPUT_KEY,
+    INPUT_MOUSE
+};
+
+struct InputBinding {
+    InputDevice device;
+    int code;
+};
+
+#define INPUT_BINDINGS_PER_ACTION 2
+#define INPUT_BINDINGS_FILE "controls.txt"
+#define INPUT_LATENCY_SMOOTHING 0.1     // weight of each new latency sample
+#define INPUT_KEY_CODES 512             // raylib's keyboard state size
+
+struct InputActionDefinition {
+    const char* name;
+    InputBinding defaults[INPUT_BINDINGS_PER_ACTION];
+};
+
+static const InputActionDefinition INPUT_ACTIONS[ACTION_COUNT] = {
+    { "move_up", { { INPUT_KEY, KEY_W }, { INPUT_NONE, 0 } } },
+    { "move_down", { { INPUT_KEY, KEY_S }, { INPUT_NONE, 0 } } },
+    { "move_left", { { INPUT_KEY, KEY_A }, { INPUT_NONE, 0 } } },
+    { "move_right", { { INPUT_KEY, KEY_D }, { INPUT_NONE, 0 } } },
+    { "attack", { { INPUT_KEY, KEY_SPACE }, { INPUT_NONE, 0 } } },
+    { "block", { { INPUT_MOUSE, MOUSE_BUTTON_RIGHT }, { INPUT_NONE, 0 } } },
+    { "dodge", { { INPUT_KEY, KEY_LEFT_SHIFT }, { INPUT_NONE, 0 } } },
+    { "pause", { { INPUT_KEY, KEY_P }, { INPUT_NONE, 0 } } },
+    { "overlay", { { INPUT_KEY, KEY_F3 }, { INPUT_NONE, 0 } } },
+};
+
+struct InputSnapshot {
+    uint32_t down = 0;
+    uint32_t pressed = 0;
+    uint32_t released = 0;
+    double poll_time = 0.0;                 // when raylib polled what this shows
+    double edge_time[ACTION_COUNT] = { 0 }; // poll time of each action's last edge
+
+    bool Down(InputAction action) const {
+        return (down >> action) & 1;
+    }
+
+    bool Pressed(InputAction action) const {
+        return (pressed >> action) & 1;
+    }
+
+    bool Released(InputAction action) const {
+        return (released >> action) & 1;
+    }
+};
+
+struct InputLatency {
+    double average_ms = 0.0;
+    double max_ms = 0.0;
+    uint32_t samples = 0;
+};
+
+class InputSystem {
+public:
+    static InputSystem* GetInstance() {
+        static InputSystem instance;
+        return &instance;
+    }
+
+    // Once per frame, before any scene updates
+    void Sample() {
+        InputSnapshot next;
+        next.poll_time = last_poll_time;
+        for (int action = 0; action < ACTION_COUNT; action++) {
+            uint32_t bit = 1u << action;
+            next.edge_time[action] = snapshot.edge_time[action];
+
+            bool down = false, pressed = false, released = false;
+            ReadBindings(action, down, pressed, released);
+            if (down) next.down |= bit;
+            if (pressed) next.pressed |= bit;
+            if (released) next.released |= bit;
+            if (pressed || released) next.edge_time[action] = next.poll_time;
+        }
+
+        snapshot = next;
+        if (snapshot.pressed != 0) awaiting_present = true;
+    }
+
+    // Polls raylib again unless that would drop an edge; true if it did
+    bool Repoll() {
+        for (int key = 1; key < INPUT_KEY_CODES; key++) {
+            if (IsKeyPressed(key) || IsKeyReleased(key)) return false;
+        }
+        for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++) {
+            if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button)) return false;
+        }
+
+        PollInputEvents();
+        last_poll_time = GetTime();
+        return true;
+    }
+
+    const InputSnapshot& Get() const {
+        return snapshot;
+    }
+
+    // Right after EndDrawing(), which is also where raylib polls input
+    void OnPresent() {
+        double now = GetTime();
+        if (awaiting_present) {
+            double ms = (now - snapshot.poll_time) * 1000.0;
+            latency.average_ms = latency.samples == 0 ? ms
+                : latency.average_ms + (ms - latency.average_ms) * INPUT_LATENCY_SMOOTHING;
+            if (ms > latency.max_ms) latency.max_ms = ms;
+            latency.samples++;
+            awaiting_present = false;
+        }
+        last_poll_time = now;
+    }
+
+    const InputLatency& GetLatency() const {
+        return latency;
+    }
+
+    void Bind(InputAction action, int slot, InputBinding binding) {
+        if (action < 0 || action >= ACTION_COUNT || slot < 0 || slot >= INPUT_BINDINGS_PER_ACTION) return;
+        bindings[action][slot] = binding;
+    }
+
+    InputBinding GetBinding(InputAction action, int slot) const {
+        if (action < 0 || action >= ACTION_COUNT || slot < 0 || slot >= INPUT_BINDINGS_PER_ACTION) return { INPUT_NONE, 0 };
+        return bindings[action][slot];
+    }
+
+    void ResetBindings() {
+        for (int action = 0; action < ACTION_COUNT; action++) {
+            for (int slot = 0; slot < INPUT_BINDINGS_PER_ACTION; slot++) {
+                bindings[action][slot] = INPUT_ACTIONS[action].defaults[slot];
+            }
+        }
+    }
+
+    // Actions missing from the file keep their current bindings
+    bool LoadBindings(const char* filename = INPUT_BINDINGS_FILE) {
+        std::ifstream file(filename);
+        if (!file.is_open()) return false;
+
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            std::string name;
+            if (!(words >> name)) continue;
+
+            int action = FindAction(name);
+            if (action < 0) {
+                std::cerr << "ERROR: Unknown input action " << name << " in " << filename << std::endl;
+                continue;
+            }
+
+            InputBinding parsed[INPUT_BINDINGS_PER_ACTION] = {};
+            std::string device;
+            int code;
+            int slot = 0;
+            while (slot < INPUT_BINDINGS_PER_ACTION && words >> device >> code) {
+                if (device == "key") parsed[slot++] = { INPUT_KEY, code };
+                else if (device == "mouse") parsed[slot++] = { INPUT_MOUSE, code };
+            }
+            for (int i = 0; i < INPUT_BINDINGS_PER_ACTION; i++) bindings[action][i] = parsed[i];
+        }
+        return true;
+    }
+
+    bool SaveBindings(const char* filename = INPUT_BINDINGS_FILE) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "ERROR: Could not write " << filename << std::endl;
+            return false;
+        }
+
+        for (int action = 0; action < ACTION_COUNT; action++) {
+            file << INPUT_ACTIONS[action].name;
+            for (const InputBinding& binding : bindings[action]) {
+                if (binding.device == INPUT_KEY) file << " key " << binding.code;
+                else if (binding.device == INPUT_MOUSE) file << " mouse " << binding.code;
+            }
+            file << "\n";
+        }
+        return true;
+    }
+
+private:
+    InputSystem() {
+        ResetBindings();
+    }
+
+    void ReadBindings(int action, bool& down, bool& pressed, bool& released) const {
+        for (const InputBinding& binding : bindings[action]) {
+            switch (binding.device) {
+                case INPUT_KEY:
+                    down = down || IsKeyDown(binding.code);
+                    pressed = pressed || IsKeyPressed(binding.code);
+                    released = released || IsKeyReleased(binding.code);
+                    break;
+                case INPUT_MOUSE:
+                    down = down || IsMouseButtonDown(binding.code);
+                    pressed = pressed || IsMouseButtonPressed(binding.code);
+                    released = released || IsMouseButtonReleased(binding.code);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    static int FindAction(const std::string& name) {
+        for (int action = 0; action < ACTION_COUNT; action++) {
+            if (name == INPUT_ACTIONS[action].name) return action;
+        }
+        return -1;
+    }
+
+    InputBinding bindings[ACTION_COUNT][INPUT_BINDINGS_PER_ACTION];
+    InputSnapshot snapshot;
+    double last_poll_time = 0.0;
+    bool awaiting_present = false;
+    InputLatency latency;
+};
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "scene_manager.hpp"
+
+// Cosmetic particles (hit sparks, slime death splats, projectile trails).
+//
+// Each kind has a fixed pool stored as parallel float arrays (x[], y[],
+// vx[], ...) so the per-frame update is a handful of straight loops over
+// contiguous floats, four lanes at a time. Dead particles are swapped with
+// the last live one, so pools stay dense and never allocate after Load().
+// Drawing packs every live particle of a pool into one instance buffer and
+// submits it as a single instanced draw of a quad, one draw per pool.
+//
+// Particles use their own random generator so emitting never disturbs the
+// game's GetRandomValue() sequence, and they are not part of snapshots.
+
+enum ParticleKind {
+    PARTICLE_SPARK,
+    PARTICLE_SPLAT,
+    PARTICLE_TRAIL,
+    PARTICLE_KIND_COUNT
+};
+
+struct ParticleDefinition {
+    const char* texture_path;   // nullptr for raylib's 1x1 white texture
+    int capacity;
+    int columns;                // frame grid of the texture
+    int rows;
+    int first_frame;            // column range played over the lifetime
+    int frame_count;
+    float gravity;              // world units per second squared, +y is down
+    float drag;                 // fraction of velocity lost per second
+    bool fade;                  // alpha follows remaining life
+};
+
+static const ParticleDefinition PARTICLE_DEFINITIONS[PARTICLE_KIND_COUNT] = {
+    { nullptr, 98304, 1, 1, 0, 1, 60.0f, 3.0f, true },
+    { "slimeDeath.png", 1024, 10, 4, 4, 6, 0.0f, 0.0f, false },
+    { "Assets/Texture/orb.png", 16384, 1, 1, 0, 1, 0.0f, 2.0f, true },
+};
+
+struct ParticleBurst {
+    float speed_min;
+    float speed_max;
+    float life_min;
+    float life_max;
+    float size_min;             // half size in world units
+    float size_max;
+    Color color;
+};
+
+static const ParticleBurst PARTICLE_HIT_SPARKS = { 80.0f, 220.0f, 0.15f, 0.4f, 1.0f, 2.0f, { 255, 230, 150, 255 } };
+static const ParticleBurst PARTICLE_HURT_SPARKS = { 60.0f, 160.0f, 0.2f, 0.5f, 1.0f, 2.5f, { 230, 41, 55, 255 } };
+static const ParticleBurst PARTICLE_DEATH_PUFF = { 20.0f, 90.0f, 0.4f, 0.8f, 1.5f, 3.0f, { 200, 200, 200, 255 } };
+static const ParticleBurst PARTICLE_SLIME_DROPLETS = { 40.0f, 140.0f, 0.3f, 0.7f, 1.0f, 2.5f, { 0, 228, 48, 255 } };
+static const ParticleBurst PARTICLE_SLIME_SPLAT = { 0.0f, 0.0f, 0.6f, 0.6f, 32.0f, 32.0f, WHITE };
+static const ParticleBurst PARTICLE_PROJECTILE_TRAIL = { 0.0f, 15.0f, 0.15f, 0.25f, 1.5f, 3.0f, { 255, 255, 255, 160 } };
+
+#if defined(__GNUC__) || defined(__clang__)
+// Four floats that may sit at any 4-byte boundary; maps to SSE or NEON
+typedef float ParticleLanes __attribute__((vector_size(16), aligned(4)));
+#define PARTICLE_LANES 4
+#else
+#define PARTICLE_LANES 1
+#endif
+
+// One instance as the shader sees it
+struct ParticleInstance {
+    float x, y, half_size, frame;
+    unsigned char r, g, b, a;
+};
+
+struct ParticlePool {
+    int count = 0;
+    int capacity = 0;
+
+    std::vector<float> x, y, vx, vy, life, inverse_max_life, half_size;
+    std::vector<float> row;
+    std::vector<Color> color;
+
+    ResourceHandle texture_handle;
+    unsigned int texture_id = 0;
+    std::vector<ParticleInstance> instances;
+    unsigned int corner_buffer = 0;
+    unsigned int instance_buffer = 0;
+    unsigned int vertex_array = 0;
+};
+
+class ParticleSystem {
+public:
+    static ParticleSystem* GetInstance() {
+        static ParticleSystem instance;
+        return &instance;
+    }
+
+    // Needs the GL context; textures come from the ResourceManager
+    void Load() {
+        if (loaded) return;
+
+        shader = LoadShaderFromMemory(PARTICLE_VERTEX_SHADER, PARTICLE_FRAGMENT_SHADER);
+        corner_location = GetShaderLocationAttrib(shader, "vertexPosition");
+        rect_location = GetShaderLocationAttrib(shader, "particleRect");
+        color_location = GetShaderLocationAttrib(shader, "particleColor");
+        grid_location = GetShaderLocation(shader, "frameGrid");
+
+        // Two triangles covering -1..1, wound counter-clockwise on screen
+        // (y down) like raylib's own quads so back-face culling keeps them
+        static const float corners[12] = { -1, -1, -1, 1, 1, 1, -1, -1, 1, 1, 1, -1 };
+
+        ResourceManager* resources = ResourceManager::GetInstance();
+        for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+            const ParticleDefinition& definition = PARTICLE_DEFINITIONS[kind];
+            ParticlePool& pool = pools[kind];
+
+            pool.capacity = (definition.capacity + 3) / 4 * 4;
+            for (std::vector<float>* array : { &pool.x, &pool.y, &pool.vx, &pool.vy, &pool.life,
+                                               &pool.inverse_max_life, &pool.half_size, &pool.row }) {
+                array->assign(pool.capacity, 0.0f);
+            }
+            pool.color.assign(pool.capacity, WHITE);
+            pool.instances.resize(pool.capacity);
+            pool.count = 0;
+
+            if (definition.texture_path != nullptr) {
+                pool.texture_handle = resources->AcquireTexture(definition.texture_path);
+                pool.texture_id = resources->GetTexture(pool.texture_handle).texture.id;
+            } else {
+                pool.texture_id = rlGetTextureIdDefault();
+            }
+
+            pool.vertex_array = rlLoadVertexArray();
+            rlEnableVertexArray(pool.vertex_array);
+
+            pool.corner_buffer = rlLoadVertexBuffer(corners, sizeof(corners), false);
+            rlSetVertexAttribute(corner_location, 2, RL_FLOAT, false, 0, 0);
+            rlEnableVertexAttribute(corner_location);
+
+            pool.instance_buffer = rlLoadVertexBuffer(nullptr, pool.capacity * sizeof(ParticleInstance), true);
+            rlSetVertexAttribute(rect_location, 4, RL_FLOAT, false, sizeof(ParticleInstance), 0);
+            rlEnableVertexAttribute(rect_location);
+            rlSetVertexAttributeDivisor(rect_location, 1);
+            rlSetVertexAttribute(color_location, 4, RL_UNSIGNED_BYTE, true, sizeof(ParticleInstance), 4 * sizeof(float));
+            rlEnableVertexAttribute(color_location);
+            rlSetVertexAttributeDivisor(color_location, 1);
+
+            rlDisableVertexArray();
+        }
+
+        loaded = true;
+    }
+
+    void Unload() {
+        if (!loaded) return;
+
+        ResourceManager* resources = ResourceManager::GetInstance();
+        for (ParticlePool& pool : pools) {
+            resources->Release(pool.texture_handle);
+            // Deleting the vertex array leaves its buffers behind
+            rlUnloadVertexArray(pool.vertex_array);
+            rlUnloadVertexBuffer(pool.corner_buffer);
+            rlUnloadVertexBuffer(pool.instance_buffer);
+            pool = ParticlePool();
+        }
+        UnloadShader(shader);
+
+        std::cout << "Particles: " << emitted << " emitted, " << dropped << " dropped (pool full), peak "
+                  << peak_live << " live" << std::endl;
+        loaded = false;
+    }
+
+    void Clear() {
+        for (ParticlePool& pool : pools) pool.count = 0;
+    }
+
+    // Emits 'count' particles from 'position' in random directions. 'row'
+    // picks the row of the frame grid, -1 for a random one.
+    void Emit(ParticleKind kind, Vector2 position, int count, const ParticleBurst& burst, int row = -1) {
+        if (!loaded) return;
+        ParticlePool& pool = pools[kind];
+        const ParticleDefinition& definition = PARTICLE_DEFINITIONS[kind];
+
+        for (int n = 0; n < count; n++) {
+            if (pool.count >= pool.capacity) {
+                dropped += count - n;
+                return;
+            }
+            int i = pool.count++;
+
+            float angle = Random() * 2.0f * PI;
+            float speed = Lerp(burst.speed_min, burst.speed_max, Random());
+            float life = Lerp(burst.life_min, burst.life_max, Random());
+
+            pool.x[i] = position.x;
+            pool.y[i] = position.y;
+            pool.vx[i] = cosf(angle) * speed;
+            pool.vy[i] = sinf(angle) * speed;
+            pool.life[i] = life;
+            pool.inverse_max_life[i] = 1.0f / life;
+            pool.half_size[i] = Lerp(burst.size_min, burst.size_max, Random());
+            pool.row[i] = (float)(row >= 0 ? row % definition.rows : (int)(Random() * definition.rows));
+            pool.color[i] = burst.color;
+        }
+        emitted += count;
+    }
+
+    void Update(float delta_time) {
+        if (!loaded) return;
+
+        int live = 0;
+        for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+            ParticlePool& pool = pools[kind];
+            if (pool.count == 0) continue;
+
+            const ParticleDefinition& definition = PARTICLE_DEFINITIONS[kind];
+            Integrate(pool, delta_time, definition.gravity * delta_time, 1.0f - std::min(definition.drag * delta_time, 1.0f));
+
+            // Swap the dead out so the live ones stay packed at the front
+            for (int i = 0; i < pool.count;) {
+                if (pool.life[i] > 0.0f) {
+                    i++;
+                    continue;
+                }
+                int last = --pool.count;
+                pool.x[i] = pool.x[last];
+                pool.y[i] = pool.y[last];
+                pool.vx[i] = pool.vx[last];
+                pool.vy[i] = pool.vy[last];
+                pool.life[i] = pool.life[last];
+                pool.inverse_max_life[i] = pool.inverse_max_life[last];
+                pool.half_size[i] = pool.half_size[last];
+                pool.row[i] = pool.row[last];
+                pool.color[i] = pool.color[last];
+            }
+            live += pool.count;
+        }
+        if (live > peak_live) peak_live = live;
+    }
+
+    // Draws inside whatever camera/target is active
+    void Draw() {
+        if (!loaded) return;
+
+        bool flushed = false;
+        for (int kind = 0; kind < PARTICLE_KIND_COUNT; kind++) {
+            ParticlePool& pool = pools[kind];
+            if (pool.count == 0) continue;
+
+            if (!flushed) {
+                rlDrawRenderBatchActive();  // keep raylib's queued sprites underneath
+                flushed = true;
+            }
+
+            const ParticleDefinition& definition = PARTICLE_DEFINITIONS[kind];
+            Pack(pool, definition);
+            rlUpdateVertexBuffer(pool.instance_buffer, pool.instances.data(), pool.count * sizeof(ParticleInstance), 0);
+
+            rlEnableShader(shader.id);
+            Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+            rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], mvp);
+            float grid[4] = { (float)definition.columns, (float)definition.rows,
+                              1.0f / definition.columns, 1.0f / definition.rows };
+            rlSetUniform(grid_location, grid, RL_SHADER_UNIFORM_VEC4, 1);
+            int texture_slot = 0;
+            rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &texture_slot, RL_SHADER_UNIFORM_INT, 1);
+            rlActiveTextureSlot(0);
+            rlEnableTexture(pool.texture_id);
+
+            rlEnableVertexArray(pool.vertex_array);
+            rlDrawVertexArrayInstanced(0, 6, pool.count);
+            rlDisableVertexArray();
+
+            rlDisableTexture();
+            rlDisableShader();
+        }
+    }
+
+    int GetLiveCount() const {
+        int live = 0;
+        for (const ParticlePool& pool : pools) live += pool.count;
+        return live;
+    }
+
+private:
+    ParticleSystem() {}
+    ParticleSystem(const ParticleSystem&) = delete;
+    void operator=(const ParticleSystem&) = delete;
+
+    static void Integrate(ParticlePool& pool, float delta_time, float gravity_step, float damping) {
+        float* x = pool.x.data();
+        float* y = pool.y.data();
+        float* vx = pool.vx.data();
+        float* vy = pool.vy.data();
+        float* life = pool.life.data();
+        int padded = (pool.count + 3) / 4 * 4;  // capacity is a multiple of 4
+
+#if PARTICLE_LANES == 4
+        for (int i = 0; i < padded; i += 4) {
+            ParticleLanes* lane_vx = (ParticleLanes*)(vx + i);
+            ParticleLanes* lane_vy = (ParticleLanes*)(vy + i);
+            *lane_vx = *lane_vx * damping;
+            *lane_vy = *lane_vy * damping + gravity_step;
+            *(ParticleLanes*)(x + i) += *lane_vx * delta_time;
+            *(ParticleLanes*)(y + i) += *lane_vy * delta_time;
+            *(ParticleLanes*)(life + i) -= delta_time;
+        }
+#else
+        for (int i = 0; i < padded; i++) {
+            vx[i] *= damping;
+            vy[i] = vy[i] * damping + gravity_step;
+            x[i] += vx[i] * delta_time;
+            y[i] += vy[i] * delta_time;
+            life[i] -= delta_time;
+        }
+#endif
+    }
+
+    static void Pack(ParticlePool& pool, const ParticleDefinition& definition) {
+        for (int i = 0; i < pool.count; i++) {
+            float age = 1.0f - pool.life[i] * pool.inverse_max_life[i];
+            int frame = (int)(age * definition.frame_count);
+            if (frame >= definition.frame_count) frame = definition.frame_count - 1;
+
+            ParticleInstance& instance = pool.instances[i];
+            instance.x = pool.x[i];
+            instance.y = pool.y[i];
+            instance.half_size = pool.half_size[i];
+            instance.frame = pool.row[i] * definition.columns + definition.first_frame + frame;
+
+            Color color = pool.color[i];
+            instance.r = color.r;
+            instance.g = color.g;
+            instance.b = color.b;
+            instance.a = definition.fade ? (unsigned char)(color.a * (1.0f - age)) : color.a;
+        }
+    }
+
+    // xorshift, [0, 1)
+    float Random() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return (rng >> 8) * (1.0f / 16777216.0f);
+    }
+
+    static constexpr const char* PARTICLE_VERTEX_SHADER = R"(#version 330
+in vec2 vertexPosition;
+in vec4 particleRect;      // x, y, half size, frame
+in vec4 particleColor;
+uniform mat4 mvp;
+uniform vec4 frameGrid;    // columns, rows, 1/columns, 1/rows
+out vec2 fragTexCoord;
+out vec4 fragColor;
+void main() {
+    vec2 cell = vec2(mod(particleRect.w, frameGrid.x), floor(particleRect.w * frameGrid.z));
+    fragTexCoord = (cell + vertexPosition * 0.5 + 0.5) * frameGrid.zw;
+    fragColor = particleColor;
+    gl_Position = mvp * vec4(particleRect.xy + vertexPosition * particleRect.z, 0.0, 1.0);
+}
+)";
+
+    static constexpr const char* PARTICLE_FRAGMENT_SHADER = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+out vec4 finalColor;
+void main() {
+    finalColor = texture(texture0, fragTexCoord) * fragColor;
+}
+)";
+
+    bool loaded = false;
+    ParticlePool pools[PARTICLE_KIND_COUNT];
+
+    Shader shader = { 0 };
+    int corner_location = -1;
+    int rect_location = -1;
+    int color_location = -1;
+    int grid_location = -1;
+
+    uint32_t rng = 0x2545F491u;
+    uint64_t emitted = 0;
+    uint64_t dropped = 0;
+    int peak_live = 0;
+};
+
+#endif
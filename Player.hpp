@@ -4,9 +4,6 @@
 #define GAME_SCENE_SPRITE_EYEBALL "Assets/Sprites/eyeball.png"
 #define GAME_SCENE_EYEBALL_PROJECTILE "Assets/Texture/orb.png"
 #define GAME_SCENE_HEART "Assets/Texture/heartscreen.png"
-#define GAME_SCENE_COLLISION_SFX "Assets/Audio/Sounds/collision.wav"
-#define GAME_SCENE_DAMAGE_SFX "Assets/Audio/Sounds/playerDamage.ogg"
-#define GAME_SCENE_DODGE_SFX "Assets/Audio/Sounds/dodgeSound.wav"
 
 
 #include <raylib.h>
@@ -15,6 +12,10 @@
 #include "Entity.hpp"
 #include "TileMap.hpp"
 #include "projectile.hpp"
+#include "scene_manager.hpp"
+#include "SfxPool.hpp"
+#include "InputSystem.hpp"
+#include "Snapshot.hpp"
 
 class Player;
 
@@ -71,6 +72,12 @@ class Player : public Entity {
 public:
     std::vector<Projectile> projectiles;
 
+    // Scratch space for sweeping projectiles against the walls each frame
+    std::vector<int> sweep_projectiles;
+    std::vector<Vector2> sweep_from;
+    std::vector<Vector2> sweep_to;
+    std::vector<TileRayHit> sweep_hits;
+
     enum class Animation_type {
         IDLE, 
         MOVING
@@ -78,15 +85,14 @@ public:
 
     Animation_type animation_state;
 
-    TileMap*  tile_map;
+    TileMap*  tile_map = nullptr;
 
     Texture2D playerSprite;
     Texture2D projectileSprite;
     Texture2D heartSprite;
 
-    Sound projectileSFX;
-    Sound damageSFX;
-    Sound dodgeSFX;
+    ResourceHandle playerSpriteHandle;
+    ResourceHandle projectileSpriteHandle;
 
 
     Rectangle playerFrameRect;
@@ -108,8 +114,12 @@ public:
         tile_map = map;
     }
     Player(Vector2 pos, float rad, float spd, int hp);
+    ~Player();
+    Player(const Player&) = delete;
+    void operator=(const Player&) = delete;
 
     void Update(float delta_time);
+    void SweepProjectiles(float delta_time);
 
     void Draw();
 
@@ -117,6 +127,9 @@ public:
 
     void HandleCollision(Entity* other_entity);
 
+    template <typename Archive>
+    void Snapshot(Archive& archive);
+
     PlayerIdle idle;
     PlayerMoving moving;
     PlayerBlocking blocking;
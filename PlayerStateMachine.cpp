@@ -2,6 +2,7 @@
 #include <raymath.h>
 
 #include "Player.hpp"
+#include "ParticleSystem.hpp"
 
 
 void Player::Update(float delta_time) {
@@ -17,11 +18,36 @@ void Player::Update(float delta_time) {
         }
     }
 
+    SweepProjectiles(delta_time);
     for (auto& p : projectiles) p.Update(delta_time);
 
     current_state->Update(*this, delta_time);
 }
 
+// Casts every live projectile's move for this frame through the tile grid
+// in one batch; the ones that would cross a wall stop where they meet it
+void Player::SweepProjectiles(float delta_time) {
+    if (tile_map == nullptr) return;
+
+    sweep_projectiles.clear();
+    sweep_from.clear();
+    sweep_to.clear();
+    for (int i = 0; i < (int)projectiles.size(); i++) {
+        Projectile& p = projectiles[i];
+        if (!p.active) continue;
+        sweep_projectiles.push_back(i);
+        sweep_from.push_back(p.position);
+        sweep_to.push_back(Vector2Add(p.position, Vector2Scale(p.velocity, delta_time)));
+    }
+
+    sweep_hits.resize(sweep_projectiles.size());
+    tile_map->RaycastBatch(sweep_from.data(), sweep_to.data(), (int)sweep_projectiles.size(), sweep_hits.data());
+
+    for (int i = 0; i < (int)sweep_projectiles.size(); i++) {
+        if (sweep_hits[i].hit) projectiles[sweep_projectiles[i]].HitWall(sweep_hits[i].point);
+    }
+}
+
 
 void Player::Draw() {
     Rectangle src = {
@@ -63,7 +89,8 @@ void Player::HandleCollision(Entity* other_entity) {
             proj.active = false; 
             other_entity->health -= 1;
             other_entity->invulnerable_timer = 1.0f;
-            PlaySound(projectileSFX);
+            SfxPool::GetInstance()->Play(SFX_HIT);
+            ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, proj.position, 12, PARTICLE_HIT_SPARKS);
         }
     }
     current_state->HandleCollision(*this, other_entity);
@@ -75,17 +102,14 @@ Player::Player(Vector2 pos, float rad, float spd, int hp) {
     speed = spd;
     health = hp;
 
-    playerSprite = LoadTexture(GAME_SCENE_SPRITE_EYEBALL);
-    projectileSprite = LoadTexture(GAME_SCENE_EYEBALL_PROJECTILE);
-    
-    projectileSFX = LoadSound(GAME_SCENE_COLLISION_SFX);
-    damageSFX = LoadSound (GAME_SCENE_DAMAGE_SFX);
-    dodgeSFX = LoadSound(GAME_SCENE_DODGE_SFX);
+    static ResourceHandle shared_handles[2];
+    ResourceManager* resources = ResourceManager::GetInstance();
+    playerSpriteHandle = resources->AcquireShared(shared_handles[0], GAME_SCENE_SPRITE_EYEBALL, ResourceType::TEXTURE);
+    projectileSpriteHandle = resources->AcquireShared(shared_handles[1], GAME_SCENE_EYEBALL_PROJECTILE, ResourceType::TEXTURE);
+
+    playerSprite = resources->GetTexture(playerSpriteHandle).texture;
+    projectileSprite = resources->GetTexture(projectileSpriteHandle).texture;
 
-    SetSoundPitch(damageSFX, 2.5);
-    SetSoundPitch(dodgeSFX, 5.5);
-    
-;
     frameWidth = (float)(playerSprite.width / 4);
     frameHeight = (float)(playerSprite.height / 4);
     currentFrame = 0;
@@ -102,6 +126,12 @@ Player::Player(Vector2 pos, float rad, float spd, int hp) {
     SetState(&idle);
 }
 
+Player::~Player() {
+    ResourceManager* resources = ResourceManager::GetInstance();
+    resources->Release(playerSpriteHandle);
+    resources->Release(projectileSpriteHandle);
+}
+
 void PlayerIdle::Enter(Player& player) {
     player.color = SKYBLUE;
     player.currentFrame = 0;
@@ -109,15 +139,17 @@ void PlayerIdle::Enter(Player& player) {
 }
 
 void PlayerIdle::Update(Player& player, float delta_time) {
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_A) || IsKeyDown(KEY_S) || IsKeyDown(KEY_D)) {
+    const InputSnapshot& input = InputSystem::GetInstance()->Get();
+
+    if (input.Down(ACTION_MOVE_UP) || input.Down(ACTION_MOVE_LEFT) || input.Down(ACTION_MOVE_DOWN) || input.Down(ACTION_MOVE_RIGHT)) {
         player.SetState(&player.moving);
     }
 
-    if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+    if (input.Down(ACTION_BLOCK)) {
         player.SetState(&player.blocking);
     }
 
-    if (IsKeyDown(KEY_SPACE)) {
+    if (input.Down(ACTION_ATTACK)) {
         player.SetState(&player.attacking);
     }
 
@@ -128,9 +160,10 @@ void PlayerIdle::Update(Player& player, float delta_time) {
 
 void PlayerIdle::HandleCollision(Player& player, Entity* other_entity) {
     if (CheckCollisionCircles(player.position, player.radius, other_entity->position, other_entity->radius) && player.invulnerable_timer <= 0.0f) {
-        PlaySound(player.damageSFX);
+        SfxPool::GetInstance()->Play(SFX_PLAYER_DAMAGE);
         player.health -= 2;
         player.invulnerable_timer = 1.0f;
+        ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, player.position, 10, PARTICLE_HURT_SPARKS);
     }
 }
 
@@ -142,21 +175,22 @@ void PlayerMoving::Enter(Player& player) {
 }
 
 void PlayerMoving::Update(Player& player, float delta_time) {
+    const InputSnapshot& input = InputSystem::GetInstance()->Get();
     player.velocity = {0, 0};
 
-    if (IsKeyDown(KEY_W)) {
+    if (input.Down(ACTION_MOVE_UP)) {
         player.velocity.y -= 1.0f;
         player.direction = 0; // UP
     }
-    if (IsKeyDown(KEY_S)) {
+    if (input.Down(ACTION_MOVE_DOWN)) {
         player.velocity.y += 1.0f;
         player.direction = 2; // DOWN
     }
-    if (IsKeyDown(KEY_A)) {
+    if (input.Down(ACTION_MOVE_LEFT)) {
         player.velocity.x -= 1.0f;
         player.direction = 1; // LEFT
     }
-    if (IsKeyDown(KEY_D)) {
+    if (input.Down(ACTION_MOVE_RIGHT)) {
         player.velocity.x += 1.0f;
         player.direction = 3; // RIGHT
     }
@@ -165,7 +199,7 @@ void PlayerMoving::Update(Player& player, float delta_time) {
     Vector2 new_position = Vector2Add(player.position, player.velocity);
 
     // Collision check
-    Player temp_player = player;
+    Entity temp_player = player;
     temp_player.position = new_position;
 
     if (player.tile_map && !player.tile_map->CheckTileCollision(&temp_player)) {
@@ -176,12 +210,12 @@ void PlayerMoving::Update(Player& player, float delta_time) {
         player.invulnerable_timer -= delta_time;
     }
 
-    if (IsKeyPressed(KEY_LEFT_SHIFT) && Vector2Length(player.velocity) > 0) {
+    if (input.Pressed(ACTION_DODGE) && Vector2Length(player.velocity) > 0) {
         player.velocity = Vector2Normalize(player.velocity);
         player.SetState(&player.dodging);
     }
 
-    if (IsKeyDown(KEY_SPACE)) {
+    if (input.Down(ACTION_ATTACK)) {
         player.SetState(&player.attacking);
     }
 
@@ -193,8 +227,9 @@ void PlayerMoving::Update(Player& player, float delta_time) {
 void PlayerMoving::HandleCollision(Player& player, Entity* other_entity) {
     if (CheckCollisionCircles(player.position, player.radius, other_entity->position, other_entity->radius) && player.invulnerable_timer <= 0.0f) {
         player.health -= 2;
-        PlaySound(player.damageSFX);
+        SfxPool::GetInstance()->Play(SFX_PLAYER_DAMAGE);
         player.invulnerable_timer = 1.0f;
+        ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, player.position, 10, PARTICLE_HURT_SPARKS);
     }
 }
 
@@ -203,7 +238,7 @@ void PlayerBlocking::Enter(Player& player) {
 }
 
 void PlayerBlocking::Update(Player& player, float delta_time) {
-    if (IsMouseButtonReleased(MOUSE_BUTTON_RIGHT)) {
+    if (InputSystem::GetInstance()->Get().Released(ACTION_BLOCK)) {
         player.SetState(&player.idle);
     }
 
@@ -215,8 +250,9 @@ void PlayerBlocking::Update(Player& player, float delta_time) {
 void PlayerBlocking::HandleCollision(Player& player, Entity* other_entity) {
     if (CheckCollisionCircles(player.position, player.radius, other_entity->position, other_entity->radius) && player.invulnerable_timer <= 0.0f) {
         player.health -= 1;
-        PlaySound(player.damageSFX);
+        SfxPool::GetInstance()->Play(SFX_PLAYER_DAMAGE);
         player.invulnerable_timer = 1.0f;
+        ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, player.position, 10, PARTICLE_HURT_SPARKS);
     }
 }
 
@@ -257,20 +293,22 @@ void PlayerAttacking::Update(Player& player, float delta_time) {
 void PlayerAttacking::HandleCollision(Player& player, Entity* other_entity) {
     if (CheckCollisionCircles(player.position, player.radius, other_entity->position, other_entity->radius) && player.invulnerable_timer <= 0.0f) {
         player.health -= 2;
-        PlaySound(player.damageSFX);
+        SfxPool::GetInstance()->Play(SFX_PLAYER_DAMAGE);
         player.invulnerable_timer = 1.0f;
+        ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, player.position, 10, PARTICLE_HURT_SPARKS);
     }
 
     if (CheckCollisionCircles(player.position, player.attack_radius, other_entity->position, other_entity->radius) && other_entity->invulnerable_timer <= 0.0f) {
         other_entity->health -= 1;
         other_entity->invulnerable_timer = 1.0f;
+        ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, other_entity->position, 12, PARTICLE_HIT_SPARKS);
     }
 }
 
 
 void PlayerDodging::Enter(Player& player) {
     player.color = LIME;
-    PlaySound(player.dodgeSFX);
+    SfxPool::GetInstance()->Play(SFX_PLAYER_DODGE);
     dodge_direction = Vector2Scale(player.velocity, 500.0f);
     player.acceleration = dodge_direction;
 }
@@ -280,7 +318,7 @@ void PlayerDodging::Update(Player& player, float delta_time) {
     player.velocity = Vector2Subtract(player.velocity, Vector2Scale(player.velocity, 5.0f * delta_time));
 
     Vector2 new_position = Vector2Add(player.position, Vector2Scale(player.velocity, delta_time));
-    Player temp_player = player;
+    Entity temp_player = player;
     temp_player.position = new_position;
 
     if (player.tile_map && !player.tile_map->CheckTileCollision(&temp_player)) {
@@ -304,8 +342,60 @@ void PlayerDodging::Update(Player& player, float delta_time) {
 
 void PlayerDodging::HandleCollision(Player& player, Entity* other_entity) {
     if (CheckCollisionCircles(player.position, player.radius, other_entity->position, other_entity->radius && player.invulnerable_timer <= 0.0f)) {
-        PlaySound(player.damageSFX);
+        SfxPool::GetInstance()->Play(SFX_PLAYER_DAMAGE);
         player.invulnerable_timer = 1.0f;
 
     }
-}
\ No newline at end of file
+}
+
+template <typename Archive>
+void Player::Snapshot(Archive& archive) {
+    archive.Value(health);
+    archive.Value(maxHealth);
+    archive.Value(position);
+    archive.Value(radius);
+    archive.Value(color);
+    archive.Value(invulnerable_timer);
+
+    archive.Value(velocity);
+    archive.Value(acceleration);
+    archive.Value(speed);
+    archive.Value(in_attacking);
+    archive.Value(attack_radius);
+    archive.Value(animation_state);
+    archive.Value(currentFrame);
+    archive.Value(direction);
+    archive.Value(animationTimer);
+    archive.Value(frameSpeed);
+    archive.Value(maxFrames);
+
+    PlayerState* states[] = { &idle, &moving, &blocking, &attacking, &dodging };
+    int state = 0;
+    for (int i = 0; i < 5; i++) {
+        if (current_state == states[i]) state = i;
+    }
+    archive.Value(state);
+    if (Archive::reading) current_state = states[(state >= 0 && state < 5) ? state : 0];
+
+    archive.Value(attacking.active_time);
+    archive.Value(dodging.dodge_direction);
+
+    uint32_t projectile_count = (uint32_t)projectiles.size();
+    archive.Count(projectile_count, sizeof(Vector2) * 2 + sizeof(float) + sizeof(Color) + sizeof(bool));
+    if (Archive::reading) {
+        projectiles.clear();
+        projectiles.reserve(projectile_count);
+    }
+
+    for (uint32_t i = 0; i < projectile_count; i++) {
+        if (Archive::reading) {
+            projectiles.push_back(Projectile({0, 0}, {0, 0}, 0.0f, projectileSprite, WHITE));
+        }
+        Projectile& projectile = projectiles[i];
+        archive.Value(projectile.position);
+        archive.Value(projectile.velocity);
+        archive.Value(projectile.radius);
+        archive.Value(projectile.color);
+        archive.Value(projectile.active);
+    }
+}
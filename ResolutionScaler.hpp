@@ -0,0 +1,146 @@
+#ifndef RESOLUTION_SCALER_HPP
+#define RESOLUTION_SCALER_HPP
+
+#include <cstdio>
+
+// Dynamic resolution for the Level world pass. Every frame it is fed how
+// long the frame took (GetFrameTime(), which includes any GPU stall at the
+// buffer swap) and how long the level itself spent updating and drawing.
+// The scale drops a step as soon as frames run over budget and only climbs
+// back after a stretch of clear headroom. A raise that is followed by a
+// drop right away doubles the wait before the next raise, so a scene that
+// sits on the edge settles instead of flipping back and forth.
+
+#define DRS_MIN_SCALE 0.5f
+#define DRS_SCALE_STEP 0.125f
+#define DRS_SMOOTHING 0.1f        // weight of the newest frame in the averages
+#define DRS_OVER_BUDGET 1.1f      // average frame time over budget*this drops a step
+#define DRS_HEADROOM 0.6f         // level work under budget*this counts as headroom
+#define DRS_SETTLE_TIME 0.5f      // seconds to let the averages settle after a change
+#define DRS_RAISE_DELAY 1.0f      // seconds of headroom needed before raising
+#define DRS_MAX_RAISE_DELAY 16.0f
+#define DRS_PROBATION 2.0f        // a drop this soon after a raise means the raise failed
+#define DRS_HISTORY 4
+
+struct ResolutionDecision {
+    double time;
+    char text[64];
+};
+
+class ResolutionScaler {
+public:
+    explicit ResolutionScaler(float target_fps) : budget(1.0f / target_fps) {
+        Reset();
+    }
+
+    void Reset() {
+        scale = 1.0f;
+        average_frame = budget;
+        average_work = 0.0f;
+        settle_timer = DRS_SETTLE_TIME;
+        headroom_timer = 0.0f;
+        raise_delay = DRS_RAISE_DELAY;
+        since_raise = 0.0f;
+        raise_on_probation = false;
+    }
+
+    void Update(float frame_time, float work_time, double now) {
+        // Loading hitches say nothing about rendering cost
+        if (frame_time > budget * 4.0f) frame_time = budget * 4.0f;
+
+        average_frame += (frame_time - average_frame) * DRS_SMOOTHING;
+        average_work += (work_time - average_work) * DRS_SMOOTHING;
+        since_raise += frame_time;
+
+        if (settle_timer > 0.0f) {
+            settle_timer -= frame_time;
+            return;
+        }
+
+        if (average_frame > budget * DRS_OVER_BUDGET) {
+            headroom_timer = 0.0f;
+            if (scale <= DRS_MIN_SCALE) return;
+
+            bool failed_raise = raise_on_probation && since_raise < DRS_PROBATION;
+            if (failed_raise && raise_delay < DRS_MAX_RAISE_DELAY) raise_delay *= 2.0f;
+            raise_on_probation = false;
+
+            Change(scale - DRS_SCALE_STEP, now, failed_raise ? "drop, raise failed" : "drop");
+            return;
+        }
+
+        // Held the raised scale through probation: it worked
+        if (raise_on_probation && since_raise >= DRS_PROBATION) {
+            raise_on_probation = false;
+            raise_delay = DRS_RAISE_DELAY;
+        }
+
+        if (scale < 1.0f && average_work < budget * DRS_HEADROOM) {
+            headroom_timer += frame_time;
+            if (headroom_timer >= raise_delay) {
+                since_raise = 0.0f;
+                raise_on_probation = true;
+                Change(scale + DRS_SCALE_STEP, now, "raise");
+            }
+        } else {
+            headroom_timer = 0.0f;
+        }
+    }
+
+    float GetScale() const {
+        return scale;
+    }
+
+    float GetAverageFrame() const {
+        return average_frame;
+    }
+
+    float GetAverageWork() const {
+        return average_work;
+    }
+
+    float GetRaiseDelay() const {
+        return raise_delay;
+    }
+
+    int GetChanges() const {
+        return changes;
+    }
+
+    // index 0 is the newest; returns nullptr past the recorded history
+    const ResolutionDecision* GetDecision(int index) const {
+        if (index < 0 || index >= DRS_HISTORY || index >= changes) return nullptr;
+        return &history[(changes - 1 - index) % DRS_HISTORY];
+    }
+
+private:
+    void Change(float new_scale, double now, const char* reason) {
+        if (new_scale < DRS_MIN_SCALE) new_scale = DRS_MIN_SCALE;
+        if (new_scale > 1.0f) new_scale = 1.0f;
+
+        ResolutionDecision& decision = history[changes % DRS_HISTORY];
+        decision.time = now;
+        std::snprintf(decision.text, sizeof(decision.text), "%s %.0f%% -> %.0f%% (%.1f ms)",
+                      reason, scale * 100.0f, new_scale * 100.0f, average_frame * 1000.0f);
+        changes++;
+
+        scale = new_scale;
+        settle_timer = DRS_SETTLE_TIME;
+        headroom_timer = 0.0f;
+    }
+
+    float budget;
+    float scale;
+    float average_frame;
+    float average_work;
+    float settle_timer;
+    float headroom_timer;
+    float raise_delay;
+    float since_raise;
+    bool raise_on_probation;
+
+    int changes = 0;
+    ResolutionDecision history[DRS_HISTORY];
+};
+
+#endif
@@ -4,12 +4,46 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <deque>
+
+#ifdef _WIN32
+#include <io.h>
+// windows.h clashes with raylib (CloseWindow, DrawText, Rectangle...), so
+// declare the one call needed here by hand
+extern "C" __declspec(dllimport) int __stdcall MoveFileExA(const char* existing, const char* replacement, unsigned long flags);
+#define SAVE_MOVEFILE_REPLACE_EXISTING 0x1
+#define SAVE_MOVEFILE_WRITE_THROUGH 0x8
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define SAVE_FILE "savegame.txt"
+#define SNAPSHOT_FILE "savegame.snap"
 
 struct SaveData {
     int wave;
     int playerHealth;
 };
 
+struct SaveRequest {
+    std::string path;
+    std::string bytes;
+    bool append = false;
+};
+
+// Saves never touch the disk on the game thread. SaveGame() serializes and
+// hands the bytes to a writer thread, which works through requests in order;
+// if several saves of the same file pile up before it gets to them, only the
+// newest is written. Each write goes to
+// "<file>.tmp", is flushed to disk, then renamed over the real file, so a
+// crash or power loss leaves either the old save or the new one, never half
+// of each.
 class SaveSystem {
 public:
     static SaveSystem* GetInstance() {
@@ -18,46 +52,248 @@ public:
     }
 
     bool SaveGame(int wave, int playerHealth) {
-        try {
-            std::ofstream saveFile("savegame.txt");
-            if (saveFile.is_open()) {
-                saveFile << wave << " " << playerHealth;
-                saveFile.close();
-                std::cout << "Saved wave: " << wave << " with health: " << playerHealth << std::endl;
-                return true;
-            } else {
-                return false;
-            }
-        } catch (const std::exception& e) {
-            return false;
-        }
+        std::ostringstream contents;
+        contents << wave << " " << playerHealth;
+
+        QueueWrite(SAVE_FILE, contents.str());
+        std::cout << "Saved wave: " << wave << " with health: " << playerHealth << std::endl;
+        return true;
     }
 
     SaveData LoadGame() {
         SaveData data = {1, 100}; // Default: wave 1, full health
-        
 
-        std::ifstream saveFile("savegame.txt");
-        if (saveFile.is_open()) {
+        std::string contents;
+        if (ReadFile(SAVE_FILE, contents)) {
+            std::istringstream saveFile(contents);
             saveFile >> data.wave >> data.playerHealth;
-            saveFile.close();
             std::cout << "Loaded wave: " << data.wave << " with health: " << data.playerHealth << std::endl;
         } else {
             std::cout << "No save file found" << std::endl;
         }
-        
+
         return data;
     }
 
+    // Binary Level snapshot (see Level::SaveSnapshot), written like any save
+    void SaveSnapshot(std::string bytes) {
+        QueueWrite(SNAPSHOT_FILE, std::move(bytes));
+    }
+
+    // An empty snapshot file means "nothing to resume"
+    void ClearSnapshot() {
+        QueueWrite(SNAPSHOT_FILE, std::string());
+    }
+
+    bool LoadSnapshot(std::string& out) {
+        return ReadFile(SNAPSHOT_FILE, out) && !out.empty();
+    }
+
     bool HasSaveFile() {
-        std::ifstream saveFile("savegame.txt");
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (Touches(SAVE_FILE)) return true;
+        }
+        std::ifstream saveFile(SAVE_FILE);
         return saveFile.good();
     }
 
+    // Queues 'bytes' to replace the file at 'path'. Never blocks on I/O.
+    void QueueWrite(const std::string& path, std::string bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        StartWriter();
+
+        SaveRequest* last = LastRequestFor(path);
+        if (last != nullptr && !last->append) {
+            last->bytes = std::move(bytes);
+            coalesced++;
+        } else {
+            pending.push_back({ path, std::move(bytes), false });
+        }
+        wake.notify_one();
+    }
+
+    // Queues 'bytes' to be appended to 'path' (created if missing). Requests
+    // run in the order they were queued, so an append queued after a
+    // replace lands in the new file.
+    void QueueAppend(const std::string& path, std::string bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        StartWriter();
+
+        SaveRequest* last = LastRequestFor(path);
+        if (last != nullptr && last->append) {
+            last->bytes += bytes;
+            coalesced++;
+        } else {
+            pending.push_back({ path, std::move(bytes), true });
+        }
+        wake.notify_one();
+    }
+
+    // Reads the newest contents of 'path', including a save that is still
+    // queued or being written.
+    bool ReadFile(const std::string& path, std::string& out) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            SaveRequest* last = LastRequestFor(path);
+            if (last != nullptr && !last->append) {
+                out = last->bytes;
+                return true;
+            }
+            if (last == nullptr && writing.path == path && !writing.append) {
+                out = writing.bytes;
+                return true;
+            }
+            // Pending appends only exist on disk once written
+            if (Touches(path)) {
+                idle.wait(lock, [this, &path]() { return !Touches(path); });
+            }
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        out = contents.str();
+        return true;
+    }
+
+    // Blocks until every queued save is on disk
+    void Flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return pending.empty() && writing.path.empty(); });
+    }
+
+    // Writes whatever is still queued, then stops the writer thread
+    void Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+            wake.notify_one();
+        }
+        if (!writer.joinable()) return;
+        writer.join();
+
+        if (coalesced > 0) {
+            std::cout << "Save writer coalesced " << coalesced << " saves" << std::endl;
+        }
+    }
+
 private:
     SaveSystem() {}
     SaveSystem(const SaveSystem&) = delete;
     void operator=(const SaveSystem&) = delete;
+
+    ~SaveSystem() {
+        Shutdown();
+    }
+
+    // Must be called with 'mutex' held
+    void StartWriter() {
+        if (writer.joinable()) return;
+        running = true;
+        writer = std::thread([this]() { WriterLoop(); });
+    }
+
+    // Must be called with 'mutex' held
+    SaveRequest* LastRequestFor(const std::string& path) {
+        for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+            if (it->path == path) return &*it;
+        }
+        return nullptr;
+    }
+
+    // Must be called with 'mutex' held
+    bool Touches(const std::string& path) {
+        return LastRequestFor(path) != nullptr || writing.path == path;
+    }
+
+    void WriterLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true) {
+            wake.wait(lock, [this]() { return !pending.empty() || !running; });
+            if (pending.empty()) break;  // stopped with nothing left to write
+
+            writing = std::move(pending.front());
+            pending.pop_front();
+
+            lock.unlock();
+            bool ok = writing.append ? AppendDurably(writing.path, writing.bytes)
+                                     : WriteAtomically(writing.path, writing.bytes);
+            if (!ok) {
+                std::cerr << "ERROR: Could not write save file " << writing.path << std::endl;
+            }
+            lock.lock();
+
+            writing = SaveRequest();
+            idle.notify_all();
+        }
+
+        idle.notify_all();
+    }
+
+    // Appends can't be made atomic with a rename; readers of appended files
+    // must cope with a torn last record after a power loss
+    static bool AppendDurably(const std::string& path, const std::string& bytes) {
+        FILE* file = std::fopen(path.c_str(), "ab");
+        if (file == nullptr) return false;
+
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        ok = ok && std::fflush(file) == 0;
+#ifdef _WIN32
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        return (std::fclose(file) == 0) && ok;
+    }
+
+    static bool WriteAtomically(const std::string& path, const std::string& bytes) {
+        std::string temp_path = path + ".tmp";
+
+        FILE* file = std::fopen(temp_path.c_str(), "wb");
+        if (file == nullptr) return false;
+
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        ok = ok && std::fflush(file) == 0;
+#ifdef _WIN32
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        ok = (std::fclose(file) == 0) && ok;
+
+        if (!ok) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        return MoveFileExA(temp_path.c_str(), path.c_str(), SAVE_MOVEFILE_REPLACE_EXISTING | SAVE_MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        if (std::rename(temp_path.c_str(), path.c_str()) != 0) return false;
+
+        // Make the rename itself durable
+        int dir = open(".", O_RDONLY);
+        if (dir >= 0) {
+            fsync(dir);
+            close(dir);
+        }
+        return true;
+#endif
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::thread writer;
+    bool running = false;
+
+    std::deque<SaveRequest> pending;
+    SaveRequest writing;        // what the writer is on right now, if anything
+    int coalesced = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,175 @@
+#ifndef SFX_POOL_HPP
+#define SFX_POOL_HPP
+
+#include <raylib.h>
+#include <cstdint>
+#include <iostream>
+#include "scene_manager.hpp"
+
+// Sound effects are decoded once (Load() at startup) and played through a
+// fixed set of voices per effect, each voice a LoadSoundAlias of the decoded
+// source. Overlapping hits get their own voice instead of restarting the one
+// that is already playing. When every voice of an effect is busy, the lowest
+// priority voice (oldest first) is stolen, or the new play is dropped if
+// everything playing outranks it. Play() never allocates. Every voice is
+// routed through its effect's mixer bus, so bus volume changes reach voices
+// that are already playing.
+
+enum SfxId {
+    SFX_HIT,
+    SFX_PLAYER_DAMAGE,
+    SFX_PLAYER_DODGE,
+    SFX_COUNT
+};
+
+enum SfxPriority {
+    SFX_PRIORITY_LOW = 0,
+    SFX_PRIORITY_NORMAL = 1,
+    SFX_PRIORITY_HIGH = 2
+};
+
+#define SFX_MAX_VOICES 16
+
+struct SfxDefinition {
+    const char* path;
+    int voice_count;
+    float pitch;
+    int priority;
+    AudioBus bus;
+};
+
+static const SfxDefinition SFX_DEFINITIONS[SFX_COUNT] = {
+    { "Assets/Audio/Sounds/collision.wav", 12, 1.0f, SFX_PRIORITY_NORMAL, BUS_SFX },
+    { "Assets/Audio/Sounds/playerDamage.ogg", 4, 2.5f, SFX_PRIORITY_HIGH, BUS_SFX },
+    { "Assets/Audio/Sounds/dodgeSound.wav", 2, 5.5f, SFX_PRIORITY_HIGH, BUS_SFX },
+};
+
+struct SfxVoice {
+    Sound alias = { 0 };
+    int priority = 0;
+    uint32_t started = 0;
+};
+
+struct SfxStats {
+    uint32_t plays = 0;
+    uint32_t stolen = 0;
+    uint32_t dropped = 0;
+};
+
+class SfxPool {
+public:
+    static SfxPool* GetInstance() {
+        static SfxPool instance;
+        return &instance;
+    }
+
+    // Needs the audio device (and the asset pack, if any) to be up already
+    void Load() {
+        if (loaded) return;
+
+        ResourceManager* resources = ResourceManager::GetInstance();
+        for (int id = 0; id < SFX_COUNT; id++) {
+            const SfxDefinition& definition = SFX_DEFINITIONS[id];
+            voice_counts[id] = 0;
+
+            sources[id] = resources->AcquireSound(definition.path);
+            Sound source = resources->GetSound(sources[id]);
+            if (!IsSoundReady(source)) {
+                std::cerr << "ERROR: Could not load sound effect " << definition.path << std::endl;
+                continue;
+            }
+
+            int count = definition.voice_count < SFX_MAX_VOICES ? definition.voice_count : SFX_MAX_VOICES;
+            for (int i = 0; i < count; i++) {
+                voices[id][i] = SfxVoice();
+                voices[id][i].alias = LoadSoundAlias(source);
+                AudioManager::AttachToBus(voices[id][i].alias.stream, definition.bus);
+            }
+            voice_counts[id] = count;
+        }
+
+        loaded = true;
+    }
+
+    void Unload() {
+        if (!loaded) return;
+
+        ResourceManager* resources = ResourceManager::GetInstance();
+        for (int id = 0; id < SFX_COUNT; id++) {
+            for (int i = 0; i < voice_counts[id]; i++) {
+                StopSound(voices[id][i].alias);
+                AudioManager::DetachFromBus(voices[id][i].alias.stream, SFX_DEFINITIONS[id].bus);
+                UnloadSoundAlias(voices[id][i].alias);
+                voices[id][i] = SfxVoice();
+            }
+            voice_counts[id] = 0;
+            resources->Release(sources[id]);
+        }
+
+        std::cout << "SFX: " << stats.plays << " plays, " << stats.stolen << " voices stolen, "
+                  << stats.dropped << " dropped" << std::endl;
+        loaded = false;
+    }
+
+    // pitch_scale multiplies the effect's base pitch. A negative priority
+    // means the effect's default one.
+    bool Play(SfxId id, float pitch_scale = 1.0f, float volume = 1.0f, int priority = -1) {
+        if (!loaded || id < 0 || id >= SFX_COUNT || voice_counts[id] == 0) return false;
+
+        const SfxDefinition& definition = SFX_DEFINITIONS[id];
+        if (priority < 0) priority = definition.priority;
+
+        SfxVoice* chosen = nullptr;
+        SfxVoice* victim = nullptr;
+        for (int i = 0; i < voice_counts[id]; i++) {
+            SfxVoice& voice = voices[id][i];
+            if (!IsSoundPlaying(voice.alias)) {
+                chosen = &voice;
+                break;
+            }
+            if (victim == nullptr || voice.priority < victim->priority ||
+                (voice.priority == victim->priority && voice.started < victim->started)) {
+                victim = &voice;
+            }
+        }
+
+        if (chosen == nullptr) {
+            if (victim->priority > priority) {
+                stats.dropped++;
+                return false;
+            }
+            StopSound(victim->alias);
+            chosen = victim;
+            stats.stolen++;
+        }
+
+        chosen->priority = priority;
+        chosen->started = ++play_counter;
+
+        SetSoundPitch(chosen->alias, definition.pitch * pitch_scale);
+        SetSoundVolume(chosen->alias, volume);
+        PlaySound(chosen->alias);
+
+        stats.plays++;
+        return true;
+    }
+
+    SfxStats GetStats() const {
+        return stats;
+    }
+
+private:
+    SfxPool() {}
+    SfxPool(const SfxPool&) = delete;
+    void operator=(const SfxPool&) = delete;
+
+    bool loaded = false;
+    uint32_t play_counter = 0;
+    SfxStats stats;
+
+    ResourceHandle sources[SFX_COUNT];
+    SfxVoice voices[SFX_COUNT][SFX_MAX_VOICES];
+    int voice_counts[SFX_COUNT] = { 0 };
+};
+
+#endif
@@ -21,7 +21,6 @@ public:
 
 class slimeWandering : public SlimeState {
 public:
-    float change_direction_cooldown;
     Vector2 move_direction;
     void Enter(Slime& enemy);
     void Update(Slime& enemy, float delta_time);
@@ -38,6 +37,7 @@ public:
 class slimeAttacking : public SlimeState {
 public:
     Vector2 attack_direction;
+    bool finished;      // the attack animation has played out
     void Enter(Slime& slime);
     void Update(Slime& slime, float delta_time);
     void HandleCollision(Slime& slime, Entity* other_entity);
@@ -76,6 +76,14 @@ public:
     void SetState(SlimeState* new_state);
     void HandleCollision(Entity* other_entity) override;
 
+    void WriteSnapshot(SnapshotWriter& writer) override;
+    void ReadSnapshot(SnapshotReader& reader, Entity* player) override;
+
+    template <typename Archive>
+    void Snapshot(Archive& archive, Entity* player);
+
+    static Behavior AttackRecovery(Slime& slime);
+
 private:
     SlimeState* current_state;
     bool flash_visible;
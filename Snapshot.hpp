@@ -0,0 +1,107 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Binary snapshots of a running Level (Level::SaveSnapshot/LoadSnapshot).
+//
+// Each snapshotted class has one Snapshot(archive) template that lists its
+// fields once; it writes when given a SnapshotWriter and reads when given a
+// SnapshotReader, so the two directions can't drift apart. Values are copied
+// raw, which keeps a save a few memcpys, so snapshots are only meant to be
+// read back by the same build. Bump SNAPSHOT_VERSION whenever a Snapshot()
+// function changes.
+
+#define SNAPSHOT_MAGIC "DDSN"
+#define SNAPSHOT_VERSION 3
+
+class SnapshotWriter {
+public:
+    static constexpr bool reading = false;
+
+    explicit SnapshotWriter(size_t reserve = 0) {
+        bytes.reserve(reserve);
+    }
+
+    template <typename T>
+    void Value(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values are copied raw");
+        bytes.append((const char*)&value, sizeof(T));
+    }
+
+    // Element count of a list that follows, each element at least
+    // 'min_element_size' bytes (only checked when reading)
+    void Count(uint32_t& count, size_t /*min_element_size*/) {
+        Value(count);
+    }
+
+    void Header() {
+        bytes.append(SNAPSHOT_MAGIC, 4);
+        Value((uint32_t)SNAPSHOT_VERSION);
+    }
+
+    std::string bytes;
+};
+
+class SnapshotReader {
+public:
+    static constexpr bool reading = true;
+
+    explicit SnapshotReader(const std::string& source) : data(source.data()), size(source.size()) {}
+
+    // Reads past the end leave 'value' zeroed and mark the reader failed, so
+    // callers can read everything and check Failed() once at the end.
+    template <typename T>
+    void Value(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values are copied raw");
+        if (failed || size - offset < sizeof(T)) {
+            failed = true;
+            std::memset((void*)&value, 0, sizeof(T));
+            return;
+        }
+        std::memcpy((void*)&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    // A count the rest of the snapshot can't possibly hold is corruption;
+    // fail instead of letting the caller reserve for it
+    void Count(uint32_t& count, size_t min_element_size) {
+        Value(count);
+        if (min_element_size > 0 && count > (size - offset) / min_element_size) {
+            failed = true;
+            count = 0;
+        }
+    }
+
+    bool Header() {
+        if (size < 4 || std::memcmp(data, SNAPSHOT_MAGIC, 4) != 0) {
+            failed = true;
+            return false;
+        }
+        offset = 4;
+
+        uint32_t version = 0;
+        Value(version);
+        if (version != SNAPSHOT_VERSION) failed = true;
+        return !failed;
+    }
+
+    bool Failed() const {
+        return failed;
+    }
+
+    bool AtEnd() const {
+        return offset == size;
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+};
+
+#endif
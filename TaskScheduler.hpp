@@ -0,0 +1,278 @@
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <raylib.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs long jobs a slice at a time so no single frame has to carry them.
+//
+// Submit() registers a task whose step is called once per frame on the main
+// thread with a TaskSlice; the step does work until the slice expires and
+// returns true once the whole job is finished. RunFrame() hands out slices
+// until TASK_FRAME_BUDGET_US of the frame is used: overdue tasks first
+// (earliest deadline first), then by priority, then oldest first. A task
+// past its deadline still gets its slice when the frame budget is gone.
+//
+// RunInBackground() runs 'work' on a worker thread and then 'finish' as a
+// one-step task on the main thread, which is where anything touching
+// raylib or GL has to happen. 'work' must not call raylib.
+//
+// Everything but the worker side is main thread only.
+
+enum TaskPriority {
+    TASK_PRIORITY_LOW = 0,
+    TASK_PRIORITY_NORMAL = 1,
+    TASK_PRIORITY_HIGH = 2
+};
+
+#define TASK_FRAME_BUDGET_US 2000
+#define TASK_DEFAULT_SLICE_US 1000
+#define TASK_MAX_WORKERS 2
+
+typedef uint32_t TaskId;
+#define TASK_NONE 0u
+
+class TaskSlice {
+public:
+    explicit TaskSlice(std::chrono::steady_clock::time_point end) : end(end) {
+    }
+
+    bool Expired() const {
+        return std::chrono::steady_clock::now() >= end;
+    }
+
+private:
+    std::chrono::steady_clock::time_point end;
+};
+
+using TaskStep = std::function<bool(const TaskSlice&)>;
+
+struct TaskStats {
+    uint64_t steps = 0;
+    uint64_t finished = 0;
+    uint64_t background_jobs = 0;
+    uint64_t late = 0;          // finished after their deadline
+    uint64_t over_budget = 0;   // frames where overdue tasks ran past the budget
+};
+
+class TaskScheduler {
+public:
+    static TaskScheduler* GetInstance() {
+        static TaskScheduler instance;
+        return &instance;
+    }
+
+    // 'slice_us' is how long each step may run; 'deadline' is a GetTime()
+    // value, 0 for none
+    TaskId Submit(const char* name, TaskStep step, TaskPriority priority = TASK_PRIORITY_NORMAL,
+                  int slice_us = TASK_DEFAULT_SLICE_US, double deadline = 0.0) {
+        Task task;
+        task.id = next_id++;
+        task.name = name;
+        task.step = std::move(step);
+        task.priority = priority;
+        task.slice_us = slice_us;
+        task.deadline = deadline;
+        task.order = next_order++;
+        tasks.push_back(std::move(task));
+        return tasks.back().id;
+    }
+
+    TaskId RunInBackground(const char* name, std::function<void()> work, std::function<void()> finish,
+                           TaskPriority priority = TASK_PRIORITY_NORMAL) {
+        TaskId id = Submit(name, [finish](const TaskSlice&) {
+            if (finish) finish();
+            return true;
+        }, priority);
+        tasks.back().waiting = true;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) StartWorkers();
+        jobs.push_back({ id, std::move(work) });
+        wake.notify_one();
+        stats.background_jobs++;
+        return id;
+    }
+
+    bool IsPending(TaskId id) const {
+        for (const Task& task : tasks) {
+            if (task.id == id) return true;
+        }
+        return false;
+    }
+
+    bool HasWork() const {
+        return !tasks.empty();
+    }
+
+    // The step is never called again; background work already running
+    // finishes, but its 'finish' is dropped
+    void Cancel(TaskId id) {
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (tasks[i].id == id) {
+                tasks.erase(tasks.begin() + i);
+                return;
+            }
+        }
+    }
+
+    // Once per frame on the main thread
+    void RunFrame(int budget_us = TASK_FRAME_BUDGET_US) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (TaskId id : completed) {
+                Task* task = Find(id);
+                if (task != nullptr) task->waiting = false;
+            }
+            completed.clear();
+        }
+        if (tasks.empty()) return;
+
+        auto start = std::chrono::steady_clock::now();
+        auto frame_end = start + std::chrono::microseconds(budget_us);
+        double now_seconds = GetTime();
+        uint32_t frame = ++frame_number;
+        bool went_over = false;
+
+        while (true) {
+            Task* next = nullptr;
+            for (Task& task : tasks) {
+                if (task.waiting || task.last_frame == frame) continue;
+                if (next == nullptr || Before(task, *next, now_seconds)) next = &task;
+            }
+            if (next == nullptr) break;
+
+            auto now = std::chrono::steady_clock::now();
+            bool overdue = next->deadline > 0.0 && now_seconds >= next->deadline;
+            if (now >= frame_end && !overdue) break;
+            if (now >= frame_end) went_over = true;
+
+            auto slice_end = now + std::chrono::microseconds(next->slice_us);
+            if (!overdue && slice_end > frame_end) slice_end = frame_end;
+
+            next->last_frame = frame;
+            TaskId id = next->id;
+            double deadline = next->deadline;
+            // The step may submit or cancel tasks, which moves 'next'
+            TaskStep step = next->step;
+            bool done = step(TaskSlice(slice_end));
+            stats.steps++;
+
+            if (done) {
+                stats.finished++;
+                if (deadline > 0.0 && GetTime() > deadline) stats.late++;
+                Cancel(id);
+            }
+        }
+        if (went_over) stats.over_budget++;
+    }
+
+    const TaskStats& GetStats() const {
+        return stats;
+    }
+
+    // Drops queued background work and joins the workers
+    void Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            jobs.clear();
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+        workers.clear();
+        tasks.clear();
+
+        std::cout << "Tasks: " << stats.finished << " finished in " << stats.steps << " steps, "
+                  << stats.background_jobs << " on workers, " << stats.late << " late, "
+                  << stats.over_budget << " frames over budget" << std::endl;
+    }
+
+private:
+    struct Task {
+        TaskId id;
+        const char* name;
+        TaskStep step;
+        TaskPriority priority;
+        int slice_us;
+        double deadline;
+        uint64_t order;
+        bool waiting = false;       // background work not done yet
+        uint32_t last_frame = 0;    // one step per task per frame
+    };
+
+    struct Job {
+        TaskId id;
+        std::function<void()> work;
+    };
+
+    TaskScheduler() = default;
+
+    ~TaskScheduler() {
+        if (!workers.empty()) Shutdown();
+    }
+
+    static bool Before(const Task& a, const Task& b, double now) {
+        bool a_overdue = a.deadline > 0.0 && now >= a.deadline;
+        bool b_overdue = b.deadline > 0.0 && now >= b.deadline;
+        if (a_overdue != b_overdue) return a_overdue;
+        if (a_overdue && a.deadline != b.deadline) return a.deadline < b.deadline;
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return a.order < b.order;
+    }
+
+    Task* Find(TaskId id) {
+        for (Task& task : tasks) {
+            if (task.id == id) return &task;
+        }
+        return nullptr;
+    }
+
+    // Must be called with 'mutex' held
+    void StartWorkers() {
+        unsigned int cores = std::thread::hardware_concurrency();
+        unsigned int count = cores > 1 ? cores - 1 : 1;
+        if (count > TASK_MAX_WORKERS) count = TASK_MAX_WORKERS;
+        for (unsigned int i = 0; i < count; i++) {
+            workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            job.work();
+            lock.lock();
+            completed.push_back(job.id);
+        }
+    }
+
+    std::vector<Task> tasks;
+    TaskId next_id = 1;
+    uint64_t next_order = 0;
+    uint32_t frame_number = 0;
+    TaskStats stats;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    std::vector<TaskId> completed;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+#endif
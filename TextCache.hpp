@@ -0,0 +1,158 @@
+#ifndef TEXT_CACHE_HPP
+#define TEXT_CACHE_HPP
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// One line of UI text whose glyph quads are laid out once and reused.
+//
+// DrawText() looks up every glyph and works out every quad each time it is
+// called, and TextFormat() reformats the string even when the value behind
+// it hasn't changed. A CachedText keeps the string, the quads (already in
+// texture coordinates) and the width, and only lays out again when Set()
+// is given a different string or value. Drawing is a straight run of quads
+// into rlgl's batch; every line drawn with the same font lands in the same
+// draw call. Steady state costs no allocation, no snprintf and no glyph
+// lookups.
+//
+// Layout and spacing follow DrawText()/MeasureText(), so with the default
+// font a CachedText replaces them pixel for pixel. Text is a single line.
+
+class CachedText {
+public:
+    // 'font' defaults to raylib's default font, which needs a window, so the
+    // layout itself waits until the first GetWidth() or Draw()
+    explicit CachedText(int font_size = 20, Font font = { 0 }) : font_size(font_size), font(font) {
+    }
+
+    void Set(const char* new_text) {
+        if (text == new_text) return;
+        text = new_text;
+        dirty = true;
+    }
+
+    // Formats only when the value changes
+    void Set(const char* format, int value) {
+        Set(format, value, 0);
+    }
+
+    void Set(const char* format, int a, int b) {
+        if (format == last_format && a == last_a && b == last_b && !text.empty()) return;
+        last_format = format;
+        last_a = a;
+        last_b = b;
+
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), format, a, b);
+        Set(buffer);
+    }
+
+    const std::string& GetText() const {
+        return text;
+    }
+
+    // Same as MeasureText() on the current text
+    float GetWidth() {
+        Layout();
+        return width;
+    }
+
+    void Draw(int x, int y, Color color) {
+        Layout();
+        if (quads.empty()) return;
+
+        rlCheckRenderBatchLimit(4 * (int)quads.size());
+        rlSetTexture(texture_id);
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (const GlyphQuad& quad : quads) {
+            float left = (float)x + quad.x, top = (float)y + quad.y;
+            rlTexCoord2f(quad.u0, quad.v0);
+            rlVertex2f(left, top);
+            rlTexCoord2f(quad.u0, quad.v1);
+            rlVertex2f(left, top + quad.height);
+            rlTexCoord2f(quad.u1, quad.v1);
+            rlVertex2f(left + quad.width, top + quad.height);
+            rlTexCoord2f(quad.u1, quad.v0);
+            rlVertex2f(left + quad.width, top);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    // Centered in 'bounds' the way the menus center their labels
+    void DrawCentered(Rectangle bounds, Color color) {
+        Draw((int)(bounds.x + bounds.width / 2 - (int)GetWidth() / 2), (int)(bounds.y + bounds.height / 2 - font_size / 2), color);
+    }
+
+private:
+    struct GlyphQuad {
+        float x, y, width, height;
+        float u0, v0, u1, v1;
+    };
+
+    void Layout() {
+        Font source = font.texture.id != 0 ? font : GetFontDefault();
+        // The default font comes back with a new texture if the window is recreated
+        if (!dirty && source.texture.id == texture_id) return;
+        dirty = false;
+        texture_id = source.texture.id;
+        quads.clear();
+        width = 0.0f;
+        if (texture_id == 0) return;
+
+        // DrawText() rules: at least size 10, one pixel of spacing per 10
+        int size = font_size < 10 ? 10 : font_size;
+        float spacing = (float)(size / 10);
+        float scale = (float)size / source.baseSize;
+        float padding = (float)source.glyphPadding;
+
+        float offset = 0.0f;
+        float advance_total = 0.0f;
+        int glyph_count = 0;
+        for (size_t i = 0; i < text.size();) {
+            int bytes = 0;
+            int codepoint = GetCodepointNext(&text[i], &bytes);
+            i += bytes;
+            int index = GetGlyphIndex(source, codepoint);
+            const Rectangle& rec = source.recs[index];
+            const GlyphInfo& glyph = source.glyphs[index];
+
+            if (codepoint != ' ' && codepoint != '\t') {
+                GlyphQuad quad;
+                quad.x = offset + (glyph.offsetX - padding) * scale;
+                quad.y = (glyph.offsetY - padding) * scale;
+                quad.width = (rec.width + 2 * padding) * scale;
+                quad.height = (rec.height + 2 * padding) * scale;
+                quad.u0 = (rec.x - padding) / source.texture.width;
+                quad.v0 = (rec.y - padding) / source.texture.height;
+                quad.u1 = (rec.x + rec.width + padding) / source.texture.width;
+                quad.v1 = (rec.y + rec.height + padding) / source.texture.height;
+                quads.push_back(quad);
+            }
+
+            offset += (glyph.advanceX == 0 ? rec.width : glyph.advanceX) * scale + spacing;
+            advance_total += glyph.advanceX != 0 ? glyph.advanceX : rec.width + glyph.offsetX;
+            glyph_count++;
+        }
+        if (glyph_count > 0) width = advance_total * scale + (glyph_count - 1) * spacing;
+    }
+
+    int font_size;
+    Font font;
+    std::string text;
+    const char* last_format = nullptr;
+    int last_a = 0;
+    int last_b = 0;
+
+    bool dirty = true;
+    unsigned int texture_id = 0;
+    std::vector<GlyphQuad> quads;
+    float width = 0.0f;
+};
+
+#endif
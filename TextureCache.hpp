@@ -0,0 +1,95 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <raylib.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "AssetPack.hpp"
+
+// Cooked textures live in cooked/ (built by cook_textures.cpp, "make cook").
+// Each file is a CookedTextureHeader followed by raw pixels in the format the
+// GPU upload wants, so loading one is a read (or a pointer into the mapped
+// pack) instead of a PNG inflate. The header keeps the hash of the PNG it was
+// made from, so an edited PNG is never shadowed by a stale cook. For a packed
+// PNG that hash comes from the pack index; only loose PNGs are read to hash.
+
+#define COOKED_TEXTURE_DIR "cooked/"
+#define COOKED_TEXTURE_MAGIC "DDTEX01"
+
+struct CookedTextureHeader {
+    char magic[8];
+    uint64_t source_hash;
+    int32_t width;
+    int32_t height;
+    int32_t format;
+    int32_t data_size;
+};
+
+class TextureCache {
+public:
+    // "Assets/Sprites/bee.png" -> "cooked/Assets_Sprites_bee.png.tex"
+    static std::string CookedPath(const std::string& source_path) {
+        std::string flat = source_path;
+        for (char& c : flat) {
+            if (c == '/' || c == '\\') c = '_';
+        }
+        return COOKED_TEXTURE_DIR + flat + ".tex";
+    }
+
+    // Hash of the PNG a cook has to match: from the pack index when the PNG is
+    // packed, otherwise read into 'loose' (free it with UnloadFileData) and
+    // hashed. Returns false if the PNG can't be found at all.
+    static bool SourceHash(const std::string& source_path, uint64_t* hash, unsigned char** loose, int* loose_size) {
+        *loose = nullptr;
+        if (AssetPack::GetInstance()->GetHash(source_path, hash)) return true;
+
+        *loose = LoadFileData(source_path.c_str(), loose_size);
+        if (*loose == nullptr) return false;
+        *hash = HashAssetBytes(*loose, (size_t)*loose_size);
+        return true;
+    }
+
+    // Fills 'out' with the cooked pixels of source_path if there is a cook made
+    // from the source with this hash. Returns false to fall back to the PNG.
+    // A cook read from a loose file hands back its buffer through 'owned' (free
+    // it with UnloadFileData after the upload); a packed cook points straight
+    // into the mapped archive and needs no cleanup.
+    static bool LoadCookedImage(const std::string& source_path, uint64_t source_hash, Image* out, unsigned char** owned) {
+        *owned = nullptr;
+        std::string cooked_path = CookedPath(source_path);
+
+        int cooked_size = 0;
+        const unsigned char* cooked = AssetPack::GetInstance()->GetData(cooked_path, &cooked_size);
+
+        if (cooked == nullptr) {
+            if (!FileExists(cooked_path.c_str())) return false;
+            *owned = LoadFileData(cooked_path.c_str(), &cooked_size);
+            cooked = *owned;
+        }
+
+        if (cooked != nullptr && cooked_size >= (int)sizeof(CookedTextureHeader)) {
+            CookedTextureHeader header;
+            std::memcpy(&header, cooked, sizeof(header));
+
+            if (std::memcmp(header.magic, COOKED_TEXTURE_MAGIC, sizeof(header.magic)) == 0 &&
+                header.data_size == cooked_size - (int)sizeof(header) &&
+                header.source_hash == source_hash) {
+                out->data = (void*)(cooked + sizeof(header));
+                out->width = header.width;
+                out->height = header.height;
+                out->format = header.format;
+                out->mipmaps = 1;
+                return true;
+            }
+        }
+
+        if (*owned != nullptr) {
+            UnloadFileData(*owned);
+            *owned = nullptr;
+        }
+        return false;
+    }
+};
+
+#endif
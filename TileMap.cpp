@@ -4,11 +4,25 @@
 #include "TileMap.hpp"
 
 void TileMap::LoadTilemapData(const char* filename) {
-    ifstream file(filename);
+    stringstream file;
+
+    int packed_size = 0;
+    const unsigned char* packed = AssetPack::GetInstance()->GetData(filename, &packed_size);
+    if (packed != nullptr) {
+        file.write((const char*)packed, packed_size);
+    } else {
+        ifstream disk_file(filename);
+        file << disk_file.rdbuf();
+    }
 
     string tilesetFile;
     file >> tilesetFile;
-    tileset = LoadTexture(tilesetFile.c_str());
+
+    ResourceManager* resources = ResourceManager::GetInstance();
+    ResourceHandle previous_tileset = tileset_handle;
+    tileset_handle = resources->AcquireTexture(tilesetFile);
+    tileset = resources->GetTexture(tileset_handle).texture;
+    resources->Release(previous_tileset);
 
     file >> TILE_COUNT;
     tileList.resize(TILE_COUNT);
@@ -32,6 +46,16 @@ void TileMap::LoadTilemapData(const char* filename) {
         cout << endl;
     }
 
+    solid.assign(mapWidth * mapHeight, 0);
+    for (int y = 0; y < mapHeight; y++) {
+        for (int x = 0; x < mapWidth; x++) {
+            int tileIndex = tilemap[y][x];
+            solid[y * mapWidth + x] = tileIndex >= 0 && tileIndex < TILE_COUNT && tileList[tileIndex].hasCollision;
+        }
+    }
+    fog.Reset(solid.data(), mapWidth, mapHeight, TILE_SIZE);
+    BuildSpawnCandidates();
+
     file >> playerPos.x >> playerPos.y;
     cout << "Player position: " << playerPos.x << " " << playerPos.y << endl;
 
@@ -42,7 +66,6 @@ void TileMap::LoadTilemapData(const char* filename) {
     file >> enemyPos3.x >> enemyPos3.y;
     cout << "Enemy position3: " << enemyPos3.x << " " << enemyPos3.y << endl;
 
-    file.close();
 }
 
 void TileMap::DrawTilemap() {
@@ -60,13 +83,15 @@ void TileMap::DrawTilemap() {
 }
 
 bool TileMap::CheckTileCollision(Entity* entity){
-    for (int y = 0; y < mapHeight; y++) {
-        for (int x = 0; x < mapWidth; x++) {
-            int tileIndex = tilemap[y][x];
+    // Only the tiles under the circle's bounding box can touch it
+    int left = max(0, (int)floorf((entity->position.x - entity->radius) / TILE_SIZE));
+    int top = max(0, (int)floorf((entity->position.y - entity->radius) / TILE_SIZE));
+    int right = min(mapWidth - 1, (int)floorf((entity->position.x + entity->radius) / TILE_SIZE));
+    int bottom = min(mapHeight - 1, (int)floorf((entity->position.y + entity->radius) / TILE_SIZE));
 
-            if (tileIndex < 0 || tileIndex >= TILE_COUNT) continue;
-
-            if (tileList[tileIndex].hasCollision) {
+    for (int y = top; y <= bottom; y++) {
+        for (int x = left; x <= right; x++) {
+            if (solid[y * mapWidth + x]) {
                 Rectangle tileRect = { x * 16.0f, y * 16.0f, 16, 16 };
 
                 if (CheckCollisionCircleRec(entity->position, entity->radius, tileRect)) {
@@ -77,4 +102,160 @@ bool TileMap::CheckTileCollision(Entity* entity){
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+// Outside the map counts as solid
+bool TileMap::IsSolid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return true;
+    return solid[y * mapWidth + x] != 0;
+}
+
+TileRayHit TileMap::Raycast(Vector2 from, Vector2 to) const {
+    int x = (int)floorf(from.x / TILE_SIZE);
+    int y = (int)floorf(from.y / TILE_SIZE);
+    if (IsSolid(x, y)) return { true, from, 0.0f, x, y };
+
+    int end_x = (int)floorf(to.x / TILE_SIZE);
+    int end_y = (int)floorf(to.y / TILE_SIZE);
+    Vector2 delta = Vector2Subtract(to, from);
+
+    // Distances are in fractions of the segment: t_max is where the next
+    // vertical/horizontal grid line is crossed, t_delta how far apart they are
+    int step_x = delta.x > 0 ? 1 : -1;
+    int step_y = delta.y > 0 ? 1 : -1;
+    float t_delta_x = delta.x != 0 ? TILE_SIZE / fabsf(delta.x) : INFINITY;
+    float t_delta_y = delta.y != 0 ? TILE_SIZE / fabsf(delta.y) : INFINITY;
+    float t_max_x = delta.x != 0 ? ((x + (step_x > 0)) * TILE_SIZE - from.x) / delta.x : INFINITY;
+    float t_max_y = delta.y != 0 ? ((y + (step_y > 0)) * TILE_SIZE - from.y) / delta.y : INFINITY;
+
+    while (x != end_x || y != end_y) {
+        float t;
+        if (t_max_x < t_max_y) {
+            t = t_max_x;
+            t_max_x += t_delta_x;
+            x += step_x;
+        } else {
+            t = t_max_y;
+            t_max_y += t_delta_y;
+            y += step_y;
+        }
+        if (t > 1.0f) break;    // rounding at the last tile
+
+        if (IsSolid(x, y)) {
+            return { true, Vector2Add(from, Vector2Scale(delta, t)), t, x, y };
+        }
+    }
+    return { false, to, 1.0f, -1, -1 };
+}
+
+void TileMap::RaycastBatch(const Vector2* from, const Vector2* to, int count, TileRayHit* hits) const {
+    for (int i = 0; i < count; i++) {
+        hits[i] = Raycast(from[i], to[i]);
+    }
+}
+
+bool TileMap::HasLineOfSight(Vector2 from, Vector2 to) const {
+    return !Raycast(from, to).hit;
+}
+
+void TileMap::BuildSpawnCandidates() {
+    int count = mapWidth * mapHeight;
+
+    // Chessboard distance transform, one pass each way
+    vector<int> distance(count);
+    auto at = [&](int x, int y) {
+        return (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) ? 0 : distance[y * mapWidth + x];
+    };
+    for (int y = 0; y < mapHeight; y++) {
+        for (int x = 0; x < mapWidth; x++) {
+            int& d = distance[y * mapWidth + x];
+            if (solid[y * mapWidth + x]) {
+                d = 0;
+                continue;
+            }
+            d = min(min(at(x - 1, y), at(x - 1, y - 1)), min(at(x, y - 1), at(x + 1, y - 1))) + 1;
+        }
+    }
+    for (int y = mapHeight - 1; y >= 0; y--) {
+        for (int x = mapWidth - 1; x >= 0; x--) {
+            int& d = distance[y * mapWidth + x];
+            if (d == 0) continue;
+            d = min(d, min(min(at(x + 1, y), at(x + 1, y + 1)), min(at(x, y + 1), at(x - 1, y + 1))) + 1);
+        }
+    }
+    clearance.resize(count);
+    for (int i = 0; i < count; i++) clearance[i] = (unsigned char)min(distance[i], 255);
+
+    // Flood fill the walkable tiles into regions
+    region.assign(count, -1);
+    regionCount = 0;
+    largestRegion = -1;
+    int largest_size = 0;
+    vector<int> frontier;
+    for (int start = 0; start < count; start++) {
+        if (solid[start] || region[start] >= 0) continue;
+
+        int size = 0;
+        region[start] = regionCount;
+        frontier.assign(1, start);
+        while (!frontier.empty()) {
+            int tile = frontier.back();
+            frontier.pop_back();
+            size++;
+
+            int x = tile % mapWidth, y = tile / mapWidth;
+            const int neighbours[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+            for (const auto& n : neighbours) {
+                if (IsSolid(n[0], n[1])) continue;
+                int next = n[1] * mapWidth + n[0];
+                if (region[next] >= 0) continue;
+                region[next] = regionCount;
+                frontier.push_back(next);
+            }
+        }
+
+        if (size > largest_size) {
+            largest_size = size;
+            largestRegion = regionCount;
+        }
+        regionCount++;
+    }
+
+    for (int level = 0; level < SPAWN_CLEARANCE_LEVELS; level++) {
+        spawn_candidates[level].assign(regionCount, vector<int>());
+        for (int i = 0; i < count; i++) {
+            if (region[i] >= 0 && clearance[i] >= level + 1) spawn_candidates[level][region[i]].push_back(i);
+        }
+    }
+    int candidates = 0;
+    for (const auto& tiles : spawn_candidates[0]) candidates += (int)tiles.size();
+    cout << "Spawn candidates: " << candidates << " walkable tiles in " << regionCount << " regions" << endl;
+}
+
+bool TileMap::PickSpawnPoint(float radius, Vector2 focus, Rectangle exclude, float min_distance, Vector2& spawn) const {
+    if (regionCount == 0) return false;
+
+    // A circle at a tile's center reaches k tiles out once k * TILE_SIZE -
+    // TILE_SIZE / 2 < radius; all of those must be walkable
+    int reach = (int)ceilf((radius + TILE_SIZE / 2) / TILE_SIZE) - 1;
+    int level = min(max(reach + 1, 1), SPAWN_CLEARANCE_LEVELS) - 1;
+
+    int focus_x = (int)floorf(focus.x / TILE_SIZE);
+    int focus_y = (int)floorf(focus.y / TILE_SIZE);
+    int focus_region = IsSolid(focus_x, focus_y) ? largestRegion : region[focus_y * mapWidth + focus_x];
+
+    const vector<int>& tiles = spawn_candidates[level][focus_region];
+    if (tiles.empty()) return false;
+
+    for (int attempt = 0; attempt < SPAWN_ATTEMPTS; attempt++) {
+        int tile = tiles[GetRandomValue(0, (int)tiles.size() - 1)];
+        Vector2 center = { (tile % mapWidth + 0.5f) * TILE_SIZE, (tile / mapWidth + 0.5f) * TILE_SIZE };
+
+        if (CheckCollisionPointRec(center, exclude)) continue;
+        if (Vector2Distance(center, focus) < min_distance) continue;
+
+        spawn = center;
+        return true;
+    }
+    return false;
+}
@@ -5,11 +5,18 @@
 #include <raymath.h>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include "Entity.hpp"
+#include "scene_manager.hpp"
+#include "FogOfWar.hpp"
 
 using namespace std;
 
+#define TILE_SIZE 16.0f
+#define SPAWN_CLEARANCE_LEVELS 4    // spawn lists for clearances of 1 to this many tiles
+#define SPAWN_ATTEMPTS 8
+
 class TileMap;
 
 struct Tile {
@@ -17,18 +24,56 @@ struct Tile {
     bool hasCollision;
 };
 
+// Result of sweeping a segment through the tile grid
+struct TileRayHit {
+    bool hit;
+    Vector2 point;      // where the segment enters the solid tile, or its end if clear
+    float fraction;     // how far along the segment 'point' is, 0 to 1
+    int tileX, tileY;   // the solid tile, -1 if clear
+};
+
 class TileMap : public Entity{
 public: 
     Texture2D tileset;
+    ResourceHandle tileset_handle;
     vector<Tile> tileList;
     int tilemap[100][100]; 
     int mapWidth, mapHeight;
     int TILE_COUNT;
     Vector2 playerPos, enemyPos, enemyPos2, enemyPos3;
 
+    vector<unsigned char> solid;    // mapWidth*mapHeight, 1 where the tile has collision
+    FogOfWar fog;
+
+    // Built at load: clearance[i] is how many tiles a walkable tile is from
+    // the nearest solid one (chessboard distance, the map edge counts as
+    // solid), region[i] which 4-connected walkable area it belongs to (-1
+    // for solid). spawn_candidates[c - 1][r] lists the tiles of region r
+    // with at least c tiles of clearance.
+    vector<unsigned char> clearance;
+    vector<int> region;
+    int regionCount = 0;
+    int largestRegion = -1;
+    vector<vector<int>> spawn_candidates[SPAWN_CLEARANCE_LEVELS];
+
     void LoadTilemapData(const char* filename);
     void DrawTilemap();
     bool CheckTileCollision(Entity* entity);
+    bool IsSolid(int x, int y) const;
+
+    // Grid traversal (Amanatides & Woo): visits only the tiles the segment
+    // crosses, in order, and stops at the first solid one
+    TileRayHit Raycast(Vector2 from, Vector2 to) const;
+    void RaycastBatch(const Vector2* from, const Vector2* to, int count, TileRayHit* hits) const;
+    bool HasLineOfSight(Vector2 from, Vector2 to) const;
+
+    // Samples a walkable spot where a circle of 'radius' fits, in the same
+    // region as 'focus', outside 'exclude' and at least 'min_distance' from
+    // 'focus'. Gives up after SPAWN_ATTEMPTS rolls.
+    bool PickSpawnPoint(float radius, Vector2 focus, Rectangle exclude, float min_distance, Vector2& spawn) const;
+
+private:
+    void BuildSpawnCandidates();
 
 };
 
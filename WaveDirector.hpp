@@ -0,0 +1,106 @@
+#ifndef WAVE_DIRECTOR_HPP
+#define WAVE_DIRECTOR_HPP
+
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+#include "EnemyBase.hpp"
+
+// Decides what a wave is made of and hands it to Level a few enemies at a
+// time.
+//
+// QueueWave() spends a point budget in one pass: every roll picks among the
+// enemy types that still fit the remaining points, so no roll is wasted.
+// Spawn points are rolled at the same time. Level then takes spawns off the
+// queue in a TaskScheduler task with a WAVE_SPAWN_BUDGET_US slice per frame,
+// so a wave of hundreds of enemies arrives over a few frames instead of in
+// one long one.
+//
+// In horde mode waves don't wait for the previous one to be cleared: a new
+// wave is queued every HORDE_WAVE_INTERVAL seconds on top of whatever is
+// still alive, until HORDE_MAX_ENEMIES are alive or queued.
+
+#define WAVE_SPAWN_BUDGET_US 1000   // microseconds of each frame spent spawning
+#define HORDE_WAVE_INTERVAL 8.0f
+#define HORDE_MAX_ENEMIES 4000
+
+struct WaveSpawn {
+    int enemy_id;
+    Vector2 position;
+};
+
+struct WaveEnemyCost {
+    int enemy_id;
+    int points;
+};
+
+static const WaveEnemyCost WAVE_ENEMY_COSTS[] = {
+    { ENEMY_SLIME, 2 },
+    { ENEMY_GHOST, 1 },
+    { ENEMY_BEE, 3 },
+};
+
+class WaveDirector {
+public:
+    // Rolls the whole wave now; 'pick_spawn' returns a spawn position
+    template <typename SpawnPicker>
+    int QueueWave(int points, SpawnPicker pick_spawn) {
+        int queued = 0;
+        while (points > 0) {
+            int fitting[3];
+            int fitting_count = 0;
+            for (int type = 0; type < 3; type++) {
+                if (WAVE_ENEMY_COSTS[type].points <= points) fitting[fitting_count++] = type;
+            }
+            if (fitting_count == 0) break;
+
+            const WaveEnemyCost& cost = WAVE_ENEMY_COSTS[fitting[GetRandomValue(0, fitting_count - 1)]];
+            pending.push_back({ cost.enemy_id, pick_spawn() });
+            points -= cost.points;
+            queued++;
+        }
+        return queued;
+    }
+
+    bool HasPending() const {
+        return next < pending.size();
+    }
+
+    int GetPendingCount() const {
+        return (int)(pending.size() - next);
+    }
+
+    WaveSpawn TakeNext() {
+        WaveSpawn spawn = pending[next++];
+        if (next == pending.size()) {
+            // Keeps the storage for the next wave
+            pending.clear();
+            next = 0;
+        }
+        return spawn;
+    }
+
+    void Clear() {
+        pending.clear();
+        next = 0;
+    }
+
+    template <typename Archive>
+    void Snapshot(Archive& archive) {
+        uint32_t count = (uint32_t)GetPendingCount();
+        archive.Count(count, sizeof(WaveSpawn));
+        if (Archive::reading) {
+            pending.assign(count, WaveSpawn());
+            next = 0;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            archive.Value(pending[next + i]);
+        }
+    }
+
+private:
+    std::vector<WaveSpawn> pending;
+    size_t next = 0;
+};
+
+#endif
@@ -0,0 +1,116 @@
+// Loads everything listed in assets.txt from loose files and then from
+// assets.pak, alternating, and reports the median of each:
+//   read - just getting the bytes (open + read, or touching the mapping)
+//   load - the full ResourceManager acquire, decode included
+//
+//   ./asset_bench [rounds]
+//
+// Run "make pack" first. Needs a (hidden) window and an audio device.
+
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "scene_manager.hpp"
+#include "AssetPack.hpp"
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double Median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+static ResourceType TypeOf(const std::string& path) {
+    if (path.find("Sounds/") != std::string::npos || path.find(".wav") != std::string::npos) return ResourceType::SOUND;
+    if (path.find(".mp3") != std::string::npos || path.find(".ogg") != std::string::npos) return ResourceType::MUSIC;
+    return ResourceType::TEXTURE;
+}
+
+static double ReadAll(const std::vector<std::string>& paths, bool packed) {
+    auto start = std::chrono::steady_clock::now();
+    size_t touched = 0;
+    for (const std::string& path : paths) {
+        if (packed) {
+            int size = 0;
+            const unsigned char* data = AssetPack::GetInstance()->GetData(path, &size);
+            for (int i = 0; data != nullptr && i < size; i += 4096) touched += data[i];
+        } else {
+            std::ifstream file(path, std::ios::binary);
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            touched += contents.str().size();
+        }
+    }
+    double ms = MillisecondsSince(start);
+    return touched == (size_t)-1 ? 0.0 : ms;
+}
+
+static double LoadAll(const std::vector<std::string>& paths) {
+    ResourceManager* resources = ResourceManager::GetInstance();
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& path : paths) {
+        if (path.find(".txt") != std::string::npos) continue;
+        switch (TypeOf(path)) {
+            case ResourceType::SOUND: resources->AcquireSound(path); break;
+            case ResourceType::MUSIC: resources->AcquireMusic(path); break;
+            default: resources->AcquireTexture(path); break;
+        }
+    }
+    double ms = MillisecondsSince(start);
+    resources->UnloadAll();
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::stoi(argv[1]) : 9;
+
+    std::vector<std::string> paths;
+    std::ifstream list("assets.txt");
+    std::string line;
+    while (std::getline(list, line)) {
+        if (!line.empty() && line[0] != '#') paths.push_back(line);
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    InitAudioDevice();
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "asset_bench");
+
+    // The game logs every load; keep the report readable
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(nullptr);
+
+    AssetPack* pack = AssetPack::GetInstance();
+    if (!pack->Open("assets.pak")) {
+        report << "No assets.pak, run \"make pack\" first" << std::endl;
+        return 1;
+    }
+    pack->Close();
+
+    std::vector<double> read_loose, read_packed, load_loose, load_packed;
+    for (int round = 0; round < rounds; round++) {
+        read_loose.push_back(ReadAll(paths, false));
+        load_loose.push_back(LoadAll(paths));
+
+        pack->Open("assets.pak");
+        read_packed.push_back(ReadAll(paths, true));
+        load_packed.push_back(LoadAll(paths));
+        pack->Close();
+    }
+
+    report << paths.size() << " assets, median of " << rounds << " rounds (page cache warm after the first)\n"
+           << "  read: " << Median(read_loose) << " ms loose, " << Median(read_packed) << " ms packed\n"
+           << "  load: " << Median(load_loose) << " ms loose, " << Median(load_packed) << " ms packed" << std::endl;
+
+    CloseWindow();
+    CloseAudioDevice();
+    return 0;
+}
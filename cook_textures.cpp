@@ -0,0 +1,104 @@
+// Cooks every PNG listed in assets.txt into cooked/*.tex and reports how
+// long each one takes to get ready for upload before and after.
+//
+//   ./cook_textures assets.txt
+
+#include <raylib.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "TextureCache.hpp"
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::string list_path = argc > 1 ? argv[1] : "assets.txt";
+
+    std::ifstream list(list_path);
+    if (!list.is_open()) {
+        std::cerr << "ERROR: Could not open asset list " << list_path << std::endl;
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    std::filesystem::create_directories(COOKED_TEXTURE_DIR);
+
+    double total_png_ms = 0.0;
+    double total_cooked_ms = 0.0;
+    int cooked_count = 0;
+
+    std::string line;
+    while (std::getline(list, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (line.empty() || line[0] == '#' || !IsFileExtension(line.c_str(), ".png")) continue;
+
+        int source_size = 0;
+        unsigned char* source = LoadFileData(line.c_str(), &source_size);
+        if (source == nullptr) {
+            std::cerr << "ERROR: Could not read " << line << std::endl;
+            return 1;
+        }
+
+        auto png_start = std::chrono::steady_clock::now();
+        Image image = LoadImageFromMemory(".png", source, source_size);
+        double png_ms = MillisecondsSince(png_start);
+
+        if (image.data == nullptr) {
+            std::cerr << "ERROR: Could not decode " << line << std::endl;
+            UnloadFileData(source);
+            return 1;
+        }
+
+        // Bake the format LoadTexture would end up uploading anyway
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        CookedTextureHeader header;
+        std::memcpy(header.magic, COOKED_TEXTURE_MAGIC, sizeof(header.magic));
+        header.source_hash = HashAssetBytes(source, (size_t)source_size);
+        header.width = image.width;
+        header.height = image.height;
+        header.format = image.format;
+        header.data_size = GetPixelDataSize(image.width, image.height, image.format);
+
+        std::string cooked_path = TextureCache::CookedPath(line);
+        std::ofstream cooked(cooked_path, std::ios::binary | std::ios::trunc);
+        if (!cooked.is_open()) {
+            std::cerr << "ERROR: Could not write " << cooked_path << std::endl;
+            UnloadImage(image);
+            UnloadFileData(source);
+            return 1;
+        }
+        cooked.write((const char*)&header, sizeof(header));
+        cooked.write((const char*)image.data, header.data_size);
+        cooked.close();
+        UnloadImage(image);
+
+        // Time the runtime path exactly as ResourceManager takes it
+        Image cooked_image = { 0 };
+        unsigned char* owned = nullptr;
+        auto cooked_start = std::chrono::steady_clock::now();
+        bool ok = TextureCache::LoadCookedImage(line, HashAssetBytes(source, (size_t)source_size), &cooked_image, &owned);
+        double cooked_ms = MillisecondsSince(cooked_start);
+
+        UnloadFileData(source);
+        if (!ok) {
+            std::cerr << "ERROR: Cooked texture " << cooked_path << " failed to load back" << std::endl;
+            return 1;
+        }
+        if (owned != nullptr) UnloadFileData(owned);
+
+        std::cout << line << ": png " << png_ms << " ms, cooked " << cooked_ms << " ms" << std::endl;
+        total_png_ms += png_ms;
+        total_cooked_ms += cooked_ms;
+        cooked_count++;
+    }
+
+    std::cout << "Cooked " << cooked_count << " textures: png " << total_png_ms
+              << " ms total, cooked " << total_cooked_ms << " ms total" << std::endl;
+    return 0;
+}
@@ -16,8 +16,7 @@ public:
 
 private:
     Texture deathbg;
-    Music death_theme = {0};
-    bool musicLoaded = false;
+    ResourceHandle deathbg_handle;
     void UpdateVolumes();
 };
 
@@ -3,34 +3,19 @@
 #include <iostream>
 
 DeathScene::DeathScene() {
-
+    draws_on_demand = true;
 }
 
 void DeathScene::Begin() {
-    TextureData deathBackgroundData = ResourceManager::GetInstance()->GetTexture("deathbackground.png");
-    deathbg = deathBackgroundData.texture;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    deathbg_handle = resources->AcquireTexture("deathbackground.png");
+    deathbg = resources->GetTexture(deathbg_handle).texture;
 
-    if (!IsMusicReady(death_theme)) {
-        death_theme = LoadMusicStream("death_theme.ogg");
-    }
-    
-    if (IsMusicReady(death_theme)) {
-        musicLoaded = true;
-        AudioManager::GetInstance()->SetCurrentMusic(death_theme);
-        PlayMusicStream(death_theme);
-    } else {
-        std::cerr << "Failed to load menu theme music" << std::endl;
-    }
+    AudioManager::GetInstance()->PlayMusic("death_theme.ogg");
 }
 
 void DeathScene::End() {
-    if (IsMusicReady(death_theme)) {
-        StopMusicStream(death_theme);
-        UnloadMusicStream(death_theme);
-        
-        death_theme = {0};
-        musicLoaded = false;
-    }   
+    ResourceManager::GetInstance()->Release(deathbg_handle);
 }
 
 void DeathScene::Update() {
@@ -39,14 +24,6 @@ void DeathScene::Update() {
             GetSceneManager()->SwitchScene(0);
         }
     }
-
-    if (musicLoaded && IsMusicReady(death_theme)) {
-        UpdateMusicStream(death_theme);
-
-        if (!IsMusicStreamPlaying(death_theme)) {
-            PlayMusicStream(death_theme);
-        }
-    }
 }
 
 void DeathScene::Draw() {
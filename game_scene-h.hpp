@@ -7,6 +7,8 @@
 #include <iostream>
 #include <vector>
 #include "scene_manager.hpp"
+#include "EntityRegistry.hpp"
+#include "TextCache.hpp"
 
 class GameScene : public Scene {
 public:
@@ -66,12 +68,9 @@ private:
     };
     Vector2 direction = {0,0};
 
-    Sound playerCollisionSound = {0};
-    Music gameSceneMusic = {0};
-    bool musicLoaded = false;
-    bool soundLoaded = false;
 
     std::vector<Enemy> activeEnemies;
+    EntityRegistry<Enemy> enemyRegistry;
     void handleProjectileCollision(Bullet& b, Enemy& e);
     void handleEnemyProjectileCollision(Bullet& b, Player& p);
     void handleEnemyPlayerCollision(Player& p, Enemy& e);
@@ -89,6 +88,7 @@ private:
     void updatePlayerProjectile(Player& player, float deltaTime);
     void updateEnemyProjectile(Enemy& enemy, float delta_time);
     
+    Texture2D acquireTexture(ResourceHandle& handle, const char* path);
     Rectangle destinationRect(float x, float y, float& width, float& height, float scale);
     Vector2 enemyDirection(Vector2& enemy, Vector2& player);
 
@@ -106,6 +106,14 @@ private:
     Texture2D beeTexture;
     Texture2D ghostTexture;
 
+    ResourceHandle playerTextureHandle;
+    ResourceHandle roomBackgroundHandle;
+    ResourceHandle bulletTextureHandle;
+    ResourceHandle slimeTextureHandle;
+    ResourceHandle heartTextureHandle;
+    ResourceHandle beeTextureHandle;
+    ResourceHandle ghostTextureHandle;
+
 
     int playerFrame = 4;
     int slimeFrame = 8;
@@ -141,6 +149,9 @@ private:
     float spawnTimer;
     float spawnInterval;
     int gamePoint = 0;
+
+    CachedText waveText{20};
+    CachedText pointText{20};
 };
 
 #endif
\ No newline at end of file
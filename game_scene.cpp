@@ -1,5 +1,6 @@
 #include "game_scene-h.hpp"
 #include "scene_manager.hpp"
+#include "SfxPool.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -12,50 +13,17 @@ void GameScene::Begin() {
     std::cout << "GameScene::Begin() - START" << std::endl;
 
     //load textures
-    TextureData playerTextureData = ResourceManager::GetInstance()->GetTexture("eyeball.png");
-    playerTexture = playerTextureData.texture;
-
-    TextureData roomBackgroundTextureData = ResourceManager::GetInstance()->GetTexture("background.png");
-    roomBackground = roomBackgroundTextureData.texture;
-
-    TextureData bulletTextureData = ResourceManager::GetInstance()->GetTexture("orb.png");
-    bulletTexture = bulletTextureData.texture;
-
-    TextureData slimeTextureData = ResourceManager::GetInstance()->GetTexture("slime.png");
-    slimeTexture = slimeTextureData.texture;
-
-    TextureData heartTextureData = ResourceManager::GetInstance()->GetTexture("heartscreen.png");
-    heartTexture = heartTextureData.texture;
-
-    TextureData beeTextureData = ResourceManager::GetInstance()->GetTexture("bee.png");
-    beeTexture = beeTextureData.texture;
-
-    TextureData ghostTextureData = ResourceManager::GetInstance()->GetTexture("ghost.png");
-    ghostTexture = ghostTextureData.texture;
-
-    if(!IsMusicReady(gameSceneMusic)) {
-        gameSceneMusic = LoadMusicStream("symphony.ogg");
-    }
-
-    if(IsMusicReady(gameSceneMusic)) {
-        musicLoaded = true;
-        AudioManager::GetInstance() -> SetCurrentMusic(gameSceneMusic);
-        PlayMusicStream(gameSceneMusic);
-    } else {
-        std::cerr << "Failed to load game scene theme music" << std::endl;
-    }
+    playerTexture = acquireTexture(playerTextureHandle, "eyeball.png");
+    roomBackground = acquireTexture(roomBackgroundHandle, "background.png");
+    bulletTexture = acquireTexture(bulletTextureHandle, "orb.png");
+    slimeTexture = acquireTexture(slimeTextureHandle, "slime.png");
+    heartTexture = acquireTexture(heartTextureHandle, "heartscreen.png");
+    beeTexture = acquireTexture(beeTextureHandle, "bee.png");
+    ghostTexture = acquireTexture(ghostTextureHandle, "ghost.png");
+
+    AudioManager::GetInstance()->PlayMusic("symphony.ogg");
     
 
-    if(!IsSoundReady(playerCollisionSound)) {
-        playerCollisionSound = LoadSound("collision.wav");
-    }
-
-    if (IsSoundReady(playerCollisionSound)) {
-        soundLoaded = false;
-        AudioManager::GetInstance() -> SetCurrentSound(playerCollisionSound);
-    } else {
-        std::cerr << "Failed to load game scene theme music" << std::endl;
-    }
 
     
     
@@ -92,6 +60,7 @@ void GameScene::Begin() {
 void GameScene::End() {
     currentWave = 0;
     activeEnemies.clear();
+    enemyRegistry.Reset();
 
     std::ofstream file("result.txt");
     file << gamePoint << std::endl;
@@ -101,20 +70,14 @@ void GameScene::End() {
 
     std::cout << "GameScene end called" << std::endl;
 
-    if (IsMusicReady(gameSceneMusic)) {
-        StopMusicStream(gameSceneMusic);
-        UnloadMusicStream(gameSceneMusic);
-        
-        gameSceneMusic = {0};
-        musicLoaded = false;
-    }
-    if (IsSoundReady(playerCollisionSound)) {
-        StopSound(playerCollisionSound);
-        UnloadSound(playerCollisionSound);
-        
-        playerCollisionSound = {0};
-        soundLoaded = false;
-    }
+    ResourceManager* resources = ResourceManager::GetInstance();
+    resources->Release(playerTextureHandle);
+    resources->Release(roomBackgroundHandle);
+    resources->Release(bulletTextureHandle);
+    resources->Release(slimeTextureHandle);
+    resources->Release(heartTextureHandle);
+    resources->Release(beeTextureHandle);
+    resources->Release(ghostTextureHandle);
 }
 
 void GameScene::Update() {
@@ -128,14 +91,6 @@ void GameScene::Update() {
         }
     } 
 
-    if (musicLoaded && IsMusicReady(gameSceneMusic)) {
-        UpdateMusicStream(gameSceneMusic);
-
-        if (!IsMusicStreamPlaying(gameSceneMusic)) {
-            PlayMusicStream(gameSceneMusic);
-        }
-    }
-
     delta_time = GetFrameTime();
 
     animationTime += delta_time;
@@ -188,6 +143,8 @@ void GameScene::Update() {
             if(enemy.HP <= 0) {
                 enemy.position.x = enemy.position.x;
                 enemy.position.y = enemy.position.y;
+                // checkProjectileCollision() may already have reported this death
+                if (enemy.isAlive) enemyRegistry.OnDeath(enemy, enemy.id);
                 enemy.isAlive = false;
                 gamePoint += enemy.point;
             }
@@ -411,8 +368,10 @@ void GameScene::Draw() {
     
     // stat text
     // DrawText(TextFormat("PLAYER HP: %.2f", player.HP), 20, 20, 20, WHITE);
-    DrawText(("Wave: " + std::to_string(currentWave)).c_str(), screen.window_width-100, 10, 20, WHITE);
-    DrawText(("Total Point: " + std::to_string(gamePoint)).c_str(), screen.window_width-300, 10, 20, WHITE);
+    waveText.Set("Wave: %d", currentWave);
+    pointText.Set("Total Point: %d", gamePoint);
+    waveText.Draw(screen.window_width-100, 10, WHITE);
+    pointText.Draw(screen.window_width-300, 10, WHITE);
     // DrawText(("Remaining Points: " + std::to_string(pointRemaining)).c_str(), screen.window_width-400, screen.window_height -100, 20, WHITE);
 
 
@@ -447,6 +406,12 @@ float GetRandomFloat(float min, float max) {
 }
 
 
+Texture2D GameScene::acquireTexture(ResourceHandle& handle, const char* path) {
+    ResourceManager* resources = ResourceManager::GetInstance();
+    handle = resources->AcquireTexture(path);
+    return resources->GetTexture(handle).texture;
+}
+
 Rectangle GameScene::destinationRect(float x, float y, float& width, float& height, float scale) {
     return Rectangle{
         x - ((width) / 2),
@@ -486,8 +451,7 @@ void GameScene::handleProjectileCollision(Bullet& b, Enemy& e)  {
         e.HP -= b.baseDamage;       
         b.bulletPosition = {0};
         e.isHit = true;
-        SetSoundPitch(playerCollisionSound, GetRandomFloat(1,1.5));
-        PlaySound(playerCollisionSound);
+        SfxPool::GetInstance()->Play(SFX_HIT, GetRandomFloat(1,1.5));
 
         std::cout << e.HP << std::endl;
     } 
@@ -663,6 +627,7 @@ void GameScene::checkProjectileCollision(Player& player, Enemy& enemy) {
                     // Check if the enemy's HP drops to zero
                     if (enemy.HP <= 0) {
                         enemy.isAlive = false;
+                        enemyRegistry.OnDeath(enemy, enemy.id);
                         std::cout << "Enemy defeated!\n";
                     }
                     if (enemy.isHit) {
@@ -723,6 +688,7 @@ void GameScene::spawnWave(float deltaTime) {
         // Check if the enemy's cost fits within the remaining points
         if (newEnemy.cost <= pointRemaining) {
             activeEnemies.push_back(newEnemy);
+            enemyRegistry.OnSpawn(newEnemy.id);
             pointRemaining -= newEnemy.cost;
         }
     }
@@ -732,14 +698,7 @@ void GameScene::spawnWave(float deltaTime) {
 
 void GameScene::updateWave(float deltaTime) {
     // Check if all enemies are defeated
-    bool allEnemiesDefeated = true;
-    
-    for (const auto& enemy : activeEnemies) {
-        if (enemy.isAlive) {
-            allEnemiesDefeated = false;
-            break;
-        }
-    }
+    bool allEnemiesDefeated = enemyRegistry.GetLiveCount() == 0;
 
     if (waveActive) {
         // If the wave is active, spawn enemies for the wave
@@ -756,6 +715,7 @@ void GameScene::updateWave(float deltaTime) {
         if (waveTimer <= 0.0f) {
             // Prepare for the next wave
             activeEnemies.clear();  // Remove any lingering enemies
+            enemyRegistry.ClearLive();
             pointRemaining = (currentWave + 1) * 10;     // Reset points to trigger wave initialization
             currentWave++;
             waveActive = true;      // Activate the wave
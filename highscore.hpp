@@ -3,88 +3,338 @@
 
 #include <string>
 #include <vector>
-#include <algorithm>
-#include <fstream>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include "SaveSystem.hpp"
 
 #define MAX_HIGH_SCORES 10
+#define HIGH_SCORE_FILE "highscores"
+#define HIGH_SCORE_MAGIC "DDHS"
+#define HIGH_SCORE_VERSION 1
+#define HIGH_SCORE_NAME_LENGTH 16
+#define HIGH_SCORE_COMPACT_MIN_RECORDS 8192
+
+// The leaderboard keeps every score ever posted, not just the top ten.
+//
+// On disk it is two files: "<base>.dat", a sorted table written by Compact(),
+// and "<base>.log", where AddHighScore() appends one fixed-size record per
+// score through the SaveSystem writer. Loading reads the table and replays
+// the log on top. Once the log grows past half the table (or
+// HIGH_SCORE_COMPACT_MIN_RECORDS) it is folded back into the table, so
+// writing stays amortized O(1) per score. Every record carries a sequence
+// number and the table stores the next one it hasn't seen, so log records
+// from before a compaction are skipped if the game dies between the table
+// write and the log truncation.
+//
+// In memory the scores sit in a treap keyed on (score descending, sequence
+// ascending) with subtree sizes, so inserts, rank lookups and "the entry at
+// rank k" are all O(log n) and a page of the board is O(log n + page size).
+
+struct HighScoreRecord {
+    int32_t score;
+    uint32_t sequence;
+    char name[HIGH_SCORE_NAME_LENGTH];  // zero padded, not always terminated
+};
+
+struct HighScoreTableHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t next_sequence;
+    uint32_t count;
+};
 
 struct HighScoreEntry {
     std::string playerName;
     int score;
-    
-    HighScoreEntry(const std::string& name = "???", int scoreValue = 0) 
-        : playerName(name), score(scoreValue) {}
-        
-    bool operator<(const HighScoreEntry& other) const {
-        return score > other.score; // Sort in descending order
-    }
+    int rank;
+
+    HighScoreEntry(const std::string& name = "???", int scoreValue = 0, int rankValue = 0)
+        : playerName(name), score(scoreValue), rank(rankValue) {}
 };
 
 class HighScoreManager {
-private:
-    std::vector<HighScoreEntry> highScores;
-    std::string fileName;
-    
 public:
-    HighScoreManager(const std::string& file = "highscores.dat") 
-        : fileName(file) {
+    static HighScoreManager* GetInstance() {
+        static HighScoreManager instance;
+        return &instance;
+    }
+
+    HighScoreManager(const std::string& base_path = HIGH_SCORE_FILE)
+        : table_path(base_path + ".dat"), log_path(base_path + ".log") {
         LoadHighScores();
     }
-    
+
     void LoadHighScores() {
-        highScores.clear();
-        std::ifstream file(fileName);
-        if (file.is_open()) {
-            std::string name;
-            int score;
-            while (file >> name >> score) {
-                highScores.push_back(HighScoreEntry(name, score));
+        nodes.clear();
+        root = -1;
+        next_sequence = 0;
+        log_records = 0;
+        last_rank = 0;
+
+        SaveSystem* saves = SaveSystem::GetInstance();
+
+        std::string table;
+        if (saves->ReadFile(table_path, table) && !table.empty()) {
+            HighScoreTableHeader header;
+            bool valid = table.size() >= sizeof(header);
+            if (valid) {
+                std::memcpy(&header, table.data(), sizeof(header));
+                valid = std::memcmp(header.magic, HIGH_SCORE_MAGIC, 4) == 0 &&
+                        header.version == HIGH_SCORE_VERSION &&
+                        header.count == (table.size() - sizeof(header)) / sizeof(HighScoreRecord);
             }
-            file.close();
-            std::sort(highScores.begin(), highScores.end()); // Sort by score (descending)
-            std::cout << "Loaded " << highScores.size() << " high scores" << std::endl;
-        } else {
-            std::cout << "No high score file found. Starting with empty list." << std::endl;
+
+            if (valid) {
+                std::vector<HighScoreRecord> sorted(header.count);
+                std::memcpy(sorted.data(), table.data() + sizeof(header), header.count * sizeof(HighScoreRecord));
+
+                nodes.reserve(sorted.size());
+                root = BuildBalanced(sorted, 0, (int)sorted.size(), 0);
+                next_sequence = header.next_sequence;
+            } else {
+                std::cerr << "ERROR: High score table " << table_path << " is corrupt, ignoring it" << std::endl;
+            }
+        }
+
+        std::string log;
+        bool torn = false;
+        if (saves->ReadFile(log_path, log)) {
+            size_t record_count = log.size() / sizeof(HighScoreRecord);
+            for (size_t i = 0; i < record_count; i++) {
+                HighScoreRecord record;
+                std::memcpy(&record, log.data() + i * sizeof(record), sizeof(record));
+                if (record.sequence < next_sequence) continue;  // already in the table
+
+                Insert(record);
+                next_sequence = record.sequence + 1;
+                log_records++;
+            }
+            // A crash mid-append leaves part of a record behind
+            torn = log.size() % sizeof(HighScoreRecord) != 0;
+        }
+
+        std::cout << "Loaded " << Count() << " high scores (" << log_records << " from the log)" << std::endl;
+
+        // Appending after a torn record would misalign everything after it
+        if (torn) Compact();
+    }
+
+    // Returns the 1-based rank the new score landed at
+    int AddHighScore(const std::string& name, int score) {
+        HighScoreRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.score = score;
+        record.sequence = next_sequence++;
+        std::memcpy(record.name, name.data(), name.size() < HIGH_SCORE_NAME_LENGTH ? name.size() : HIGH_SCORE_NAME_LENGTH);
+
+        last_rank = Insert(record);
+
+        SaveSystem::GetInstance()->QueueAppend(log_path, std::string((const char*)&record, sizeof(record)));
+        log_records++;
+
+        if (log_records >= HIGH_SCORE_COMPACT_MIN_RECORDS && log_records >= Count() / 2) {
+            Compact();
         }
+        return last_rank;
     }
-    
-    void SaveHighScores() {
-        std::ofstream file(fileName);
-        if (file.is_open()) {
-            for (const auto& entry : highScores) {
-                file << entry.playerName << " " << entry.score << std::endl;
+
+    // Rewrites the table with every score and empties the log
+    void Compact() {
+        HighScoreTableHeader header;
+        std::memcpy(header.magic, HIGH_SCORE_MAGIC, 4);
+        header.version = HIGH_SCORE_VERSION;
+        header.next_sequence = next_sequence;
+        header.count = (uint32_t)Count();
+
+        std::string table;
+        table.reserve(sizeof(header) + header.count * sizeof(HighScoreRecord));
+        table.append((const char*)&header, sizeof(header));
+        VisitInOrder(0, Count(), [&table](const HighScoreRecord& record) {
+            table.append((const char*)&record, sizeof(record));
+        });
+
+        SaveSystem* saves = SaveSystem::GetInstance();
+        saves->QueueWrite(table_path, std::move(table));
+        saves->QueueWrite(log_path, std::string());
+        log_records = 0;
+    }
+
+    // Rank a score would get if it were posted now (ties go below older scores)
+    int RankOf(int score) const {
+        int ahead = 0;
+        int t = root;
+        while (t >= 0) {
+            if (nodes[t].record.score >= score) {
+                ahead += Size(nodes[t].left) + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
             }
-            file.close();
-            std::cout << "Saved " << highScores.size() << " high scores" << std::endl;
-        } else {
-            std::cerr << "Error: Could not save high scores to file." << std::endl;
         }
+        return ahead + 1;
     }
-    
+
     bool IsHighScore(int score) const {
-        if (highScores.size() < MAX_HIGH_SCORES) {
-            return true; // Always a high score if we don't have MAX_HIGH_SCORES yet
+        return RankOf(score) <= MAX_HIGH_SCORES;
+    }
+
+    int Count() const {
+        return Size(root);
+    }
+
+    // Rank of the last AddHighScore() since loading, 0 if none
+    int GetLastRank() const {
+        return last_rank;
+    }
+
+    // Up to 'count' entries starting at 0-based position 'offset', best first
+    std::vector<HighScoreEntry> GetPage(int offset, int count) const {
+        std::vector<HighScoreEntry> page;
+        int rank = offset + 1;
+        VisitInOrder(offset, count, [&page, &rank](const HighScoreRecord& record) {
+            page.push_back(HighScoreEntry(std::string(record.name, strnlen(record.name, HIGH_SCORE_NAME_LENGTH)),
+                                          record.score, rank++));
+        });
+        return page;
+    }
+
+    std::vector<HighScoreEntry> GetHighScores() const {
+        return GetPage(0, MAX_HIGH_SCORES);
+    }
+
+private:
+    struct Node {
+        HighScoreRecord record;
+        uint32_t priority;
+        int32_t left;
+        int32_t right;
+        int32_t size;
+    };
+
+    static bool Before(const HighScoreRecord& a, const HighScoreRecord& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.sequence < b.sequence;
+    }
+
+    int Size(int t) const {
+        return t < 0 ? 0 : nodes[t].size;
+    }
+
+    void Refresh(int t) {
+        nodes[t].size = Size(nodes[t].left) + Size(nodes[t].right) + 1;
+    }
+
+    uint32_t NextPriority() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    int NewNode(const HighScoreRecord& record, uint32_t priority) {
+        nodes.push_back({ record, priority, -1, -1, 1 });
+        return (int)nodes.size() - 1;
+    }
+
+    // Splits 't' into the nodes ordered before 'key' and the rest
+    void Split(int t, const HighScoreRecord& key, int& before, int& after) {
+        if (t < 0) {
+            before = after = -1;
+            return;
+        }
+        if (Before(nodes[t].record, key)) {
+            Split(nodes[t].right, key, nodes[t].right, after);
+            before = t;
+        } else {
+            Split(nodes[t].left, key, before, nodes[t].left);
+            after = t;
         }
-        
-        return score > highScores.back().score;
-    }
-    
-    void AddHighScore(const std::string& name, int score) {
-        highScores.push_back(HighScoreEntry(name, score));
-        std::sort(highScores.begin(), highScores.end()); // Sort by score (descending)
-        
-        // Keep only the top MAX_HIGH_SCORES
-        if (highScores.size() > MAX_HIGH_SCORES) {
-            highScores.resize(MAX_HIGH_SCORES);
+        Refresh(t);
+    }
+
+    // Every node of 'a' must be ordered before every node of 'b'
+    int Merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes[a].priority > nodes[b].priority) {
+            nodes[a].right = Merge(nodes[a].right, b);
+            Refresh(a);
+            return a;
         }
-        
-        SaveHighScores();
+        nodes[b].left = Merge(a, nodes[b].left);
+        Refresh(b);
+        return b;
     }
-    
-    const std::vector<HighScoreEntry>& GetHighScores() const {
-        return highScores;
+
+    int Insert(const HighScoreRecord& record) {
+        int node = NewNode(record, NextPriority());
+        int before, after;
+        Split(root, record, before, after);
+        int rank = Size(before) + 1;
+        root = Merge(Merge(before, node), after);
+        return rank;
     }
+
+    // Builds a perfectly balanced treap from an already sorted table. The
+    // top bits of each priority come from the depth so the heap order holds
+    // without sorting anything.
+    int BuildBalanced(const std::vector<HighScoreRecord>& sorted, int begin, int end, int depth) {
+        if (begin >= end) return -1;
+        int middle = begin + (end - begin) / 2;
+
+        uint32_t priority = ((uint32_t)(63 - depth) << 26) | (NextPriority() & ((1u << 26) - 1));
+        int t = NewNode(sorted[middle], priority);
+        int left = BuildBalanced(sorted, begin, middle, depth + 1);
+        int right = BuildBalanced(sorted, middle + 1, end, depth + 1);
+        nodes[t].left = left;
+        nodes[t].right = right;
+        Refresh(t);
+        return t;
+    }
+
+    // Calls visit(record) for 'count' records in rank order starting at
+    // 0-based position 'offset'
+    template <typename Visitor>
+    void VisitInOrder(int offset, int count, Visitor visit) const {
+        // Walk down to 'offset', keeping the nodes still to visit after it
+        std::vector<int> stack;
+        int t = root;
+        while (t >= 0) {
+            int left_size = Size(nodes[t].left);
+            if (offset < left_size) {
+                stack.push_back(t);
+                t = nodes[t].left;
+            } else if (offset == left_size) {
+                stack.push_back(t);
+                break;
+            } else {
+                offset -= left_size + 1;
+                t = nodes[t].right;
+            }
+        }
+
+        while (count > 0 && !stack.empty()) {
+            t = stack.back();
+            stack.pop_back();
+            visit(nodes[t].record);
+            count--;
+
+            for (t = nodes[t].right; t >= 0; t = nodes[t].left) {
+                stack.push_back(t);
+            }
+        }
+    }
+
+    std::string table_path;
+    std::string log_path;
+
+    std::vector<Node> nodes;
+    int root = -1;
+    uint32_t next_sequence = 0;
+    int log_records = 0;
+    int last_rank = 0;
+    uint32_t rng = 0x9E3779B9u;
 };
 
 #endif // HIGH_SCORE_HPP
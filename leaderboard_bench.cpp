@@ -0,0 +1,94 @@
+// Posts a million scores to a scratch leaderboard and times inserts, rank
+// lookups, page reads, compaction and reloading it from disk.
+//
+//   ./leaderboard_bench [score count]
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "highscore.hpp"
+
+#define BENCH_BOARD "leaderboard_bench"
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void RemoveBoard() {
+    std::remove(BENCH_BOARD ".dat");
+    std::remove(BENCH_BOARD ".log");
+}
+
+int main(int argc, char** argv) {
+    int total = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int queries = 100000;
+
+    RemoveBoard();
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> scores(1, 1000000);
+
+    // Loading and compacting are chatty; report on the real stdout
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(nullptr);
+
+    SaveSystem* saves = SaveSystem::GetInstance();
+    double insert_ms, rank_ms, page_ms, compact_ms, load_ms;
+    long long checksum = 0;
+    {
+        HighScoreManager board(BENCH_BOARD);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < total; i++) {
+            checksum += board.AddHighScore("BENCH", scores(random));
+        }
+        insert_ms = MillisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < queries; i++) {
+            checksum += board.RankOf(scores(random));
+        }
+        rank_ms = MillisecondsSince(start);
+
+        std::uniform_int_distribution<int> offsets(0, board.Count() - 1);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < queries; i++) {
+            checksum += board.GetPage(offsets(random), 10).size();
+        }
+        page_ms = MillisecondsSince(start);
+
+        saves->Flush();
+        start = std::chrono::steady_clock::now();
+        board.Compact();
+        saves->Flush();
+        compact_ms = MillisecondsSince(start);
+    }
+
+    int loaded = 0;
+    bool sorted = true;
+    {
+        auto start = std::chrono::steady_clock::now();
+        HighScoreManager board(BENCH_BOARD);
+        load_ms = MillisecondsSince(start);
+        loaded = board.Count();
+
+        std::vector<HighScoreEntry> all = board.GetPage(0, loaded);
+        for (size_t i = 1; i < all.size(); i++) {
+            if (all[i].score > all[i - 1].score) sorted = false;
+        }
+    }
+
+    report << total << " scores: insert " << insert_ms * 1000000.0 / total << " ns each ("
+           << insert_ms << " ms total, including periodic compaction)" << std::endl;
+    report << "rank query " << rank_ms * 1000000.0 / queries << " ns, 10-entry page "
+           << page_ms * 1000000.0 / queries << " ns" << std::endl;
+    report << "compact + flush " << compact_ms << " ms, reload " << load_ms << " ms ("
+           << loaded << " scores, " << (sorted ? "in order" : "OUT OF ORDER") << ")" << std::endl;
+    report << "checksum " << checksum << std::endl;
+
+    saves->Shutdown();
+    RemoveBoard();
+    return loaded == total && sorted ? 0 : 1;
+}
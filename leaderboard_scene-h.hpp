@@ -5,6 +5,9 @@
 #include "main_menu_scene-h.hpp"
 #include <raylib.h>
 #include <vector>
+#include "highscore.hpp"
+
+#define LEADERBOARD_PAGE_SIZE 10
 
 class LeaderboardScene : public Scene {
 public:
@@ -17,10 +20,13 @@ public:
 
 private:
     Texture leaderboardbg;
-    Music menu_theme = {0};
-    bool musicLoaded = false;
+    ResourceHandle leaderboardbg_handle;
     void UpdateVolumes();
-    int Highscore;
+    void LoadPage(int new_page);
+
+    int page;
+    int page_count;
+    std::vector<HighScoreEntry> entries;
 };
 
 
@@ -1,60 +1,67 @@
 #include "leaderboard_scene-h.hpp"
 #include "scene_manager.hpp"
 #include <iostream>
-#include <fstream>
 
-LeaderboardScene::LeaderboardScene() {}
+LeaderboardScene::LeaderboardScene() {
+    draws_on_demand = true;
+}
 
 void LeaderboardScene::Begin() {
-    TextureData leaderboardBackgroundData = ResourceManager::GetInstance()->GetTexture("leaderboard_background.png");
-    leaderboardbg = leaderboardBackgroundData.texture;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    leaderboardbg_handle = resources->AcquireTexture("leaderboard_background.png");
+    leaderboardbg = resources->GetTexture(leaderboardbg_handle).texture;
 
-    std::ifstream infile("result.txt");
-    infile >> Highscore;
+    // Open on the page with the run that just ended, if there was one
+    int last_rank = HighScoreManager::GetInstance()->GetLastRank();
+    LoadPage(last_rank > 0 ? (last_rank - 1) / LEADERBOARD_PAGE_SIZE : 0);
 
-    if (!IsMusicReady(menu_theme)) {
-        menu_theme = LoadMusicStream("menu_theme.ogg");
-    }
-    
-    if (IsMusicReady(menu_theme)) {
-        musicLoaded = true;
-        AudioManager::GetInstance()->SetCurrentMusic(menu_theme);
-        PlayMusicStream(menu_theme);
-    } else {
-        std::cerr << "Failed to load menu theme music" << std::endl;
-    }
+    AudioManager::GetInstance()->PlayMusic("menu_theme.ogg");
 }
 
 void LeaderboardScene::End() {
-    if (IsMusicReady(menu_theme)) {
-        StopMusicStream(menu_theme);
-        UnloadMusicStream(menu_theme);
-        
-        menu_theme = {0};
-        musicLoaded = false;
-    }   
+    ResourceManager::GetInstance()->Release(leaderboardbg_handle);
+}
+
+void LeaderboardScene::LoadPage(int new_page) {
+    HighScoreManager* scores = HighScoreManager::GetInstance();
+    page_count = (scores->Count() + LEADERBOARD_PAGE_SIZE - 1) / LEADERBOARD_PAGE_SIZE;
+    if (page_count < 1) page_count = 1;
+
+    page = new_page < 0 ? 0 : (new_page >= page_count ? page_count - 1 : new_page);
+    entries = scores->GetPage(page * LEADERBOARD_PAGE_SIZE, LEADERBOARD_PAGE_SIZE);
+    MarkDirty();
 }
 
 void LeaderboardScene::Update() {
+    if (IsKeyPressed(KEY_RIGHT)) LoadPage(page + 1);
+    if (IsKeyPressed(KEY_LEFT)) LoadPage(page - 1);
+
     if (IsKeyPressed(KEY_ENTER)) {
         if (GetSceneManager() != nullptr) {
             GetSceneManager()->SwitchScene(1);
         }
     }
-
-    if (musicLoaded && IsMusicReady(menu_theme)) {
-        UpdateMusicStream(menu_theme);
-
-        if (!IsMusicStreamPlaying(menu_theme)) {
-            PlayMusicStream(menu_theme);
-        }
-    }
 }
 
 void LeaderboardScene::Draw() {
     ClearBackground(BLACK);
     DrawTexturePro(leaderboardbg, {0, 0, 2000, 2000}, {0,0,800,600}, {0,0},  0.0f,  BLUE);
     DrawText("LEADERBOARDS: ", 30, 50, 40, WHITE);
-    DrawText(std::to_string(Highscore).c_str(), 30, 100, 40, WHITE);
+
+    int last_rank = HighScoreManager::GetInstance()->GetLastRank();
+    for (size_t i = 0; i < entries.size(); i++) {
+        const HighScoreEntry& entry = entries[i];
+        int y = 110 + (int)i * 40;
+        Color color = entry.rank == last_rank ? YELLOW : WHITE;
+
+        DrawText(TextFormat("#%d", entry.rank), 30, y, 30, color);
+        DrawText(entry.playerName.c_str(), 200, y, 30, color);
+        DrawText(TextFormat("Wave %d", entry.score), 500, y, 30, color);
+    }
+    if (entries.empty()) {
+        DrawText("No scores yet", 30, 110, 30, WHITE);
+    }
+
+    DrawText(TextFormat("Page %d / %d  (LEFT / RIGHT)", page + 1, page_count), 30, 550, 20, WHITE);
     DrawText("Press ENTER to return", 500, 550, 20, WHITE);
 }
\ No newline at end of file
@@ -11,6 +11,23 @@
 #include "Ghost.hpp"
 #include "Slime.hpp"
 #include "TileMap.hpp"
+#include "Snapshot.hpp"
+#include "ResolutionScaler.hpp"
+#include "CrowdSeparation.hpp"
+#include "WaveDirector.hpp"
+#include "EntityRegistry.hpp"
+#include "TextCache.hpp"
+#include "TaskScheduler.hpp"
+
+#define AUTOSAVE_INTERVAL 5.0f
+
+// The world is drawn at this resolution and scaled up to the window by a
+// whole number, so each 16x16 tile is rasterized once at native size
+#define LEVEL_RENDER_WIDTH 640
+#define LEVEL_RENDER_HEIGHT 360
+#define LEVEL_VIEW_ZOOM 2.0f   // window pixels per world unit
+
+#define SPAWN_MIN_PLAYER_DISTANCE 200.0f
 
 class Level : public Scene {
 public:
@@ -24,7 +41,27 @@ public:
     void Update() override;
     void Draw() override;
 
+    // Binary snapshot of the whole run: player and projectiles, every enemy
+    // with its state machine and timers, the wave timer, camera and RNG.
+    // LoadSnapshot leaves the level untouched if the bytes don't parse.
+    std::string SaveSnapshot();
+    bool LoadSnapshot(const std::string& bytes);
+
+    // Begin() resumes from this snapshot instead of starting the wave fresh
+    void SetResumeSnapshot(std::string bytes);
+
+    // Internal resolution of the world pass, used by levels begun afterwards.
+    // The view always covers the same part of the world; a lower resolution
+    // just makes it blockier and cheaper.
+    static void SetRenderResolution(int width, int height);
+
+    // Endless horde: waves arrive on a timer instead of when cleared
+    static void SetHordeMode(bool enabled);
+
 private:
+    // snapshot_bench.cpp fills a level with fake entities to time snapshots
+    friend struct LevelSnapshotBench;
+
     // Game state
     bool game_ongoing;
     bool is_paused;
@@ -38,6 +75,8 @@ private:
     // Game entities
     Player* player;
     std::vector<BaseEnemy*> enemies;
+    CrowdSeparation crowd;
+    EntityRegistry<BaseEnemy> registry;
     TileMap map;
     
     // Wave system
@@ -47,10 +86,36 @@ private:
     float wave_timer;
     float wave_delay;
     bool wave_cleared;
-    
-    // Audio
-    Music game_music;
-    bool music_loaded;
+    WaveDirector wave_director;
+    TaskId spawn_task = TASK_NONE;
+    static inline bool horde_mode = false;
+
+    // World render target
+    static inline int render_width = LEVEL_RENDER_WIDTH;
+    static inline int render_height = LEVEL_RENDER_HEIGHT;
+    RenderTexture2D world_target;
+    Rectangle world_destination;
+
+    // Dynamic resolution and the F3 overlay that shows what it is doing
+    ResolutionScaler resolution_scaler;
+    double frame_work_start;
+    float last_work_time;
+    bool show_overlay;
+
+    // Saves
+    std::string resume_snapshot;
+    float autosave_timer;
+
+    // HUD and menu text, laid out only when it changes
+    CachedText health_text{30};
+    CachedText wave_text{30};
+    CachedText position_text{30};
+    CachedText enemies_text{30};
+    CachedText pause_hint_text{20};
+    CachedText game_over_text{100};
+    CachedText paused_text{60};
+    CachedText continue_text{20};
+    CachedText main_menu_text{20};
 
     // Pause menu
     Rectangle continue_button;
@@ -58,13 +123,21 @@ private:
     bool continue_hover;
     bool main_menu_hover;
 
+    void SetupWorldTarget();
     void MoveCamera(float delta_time);
     void SpawnWave(int wave_num);
+    void ScheduleSpawns();
+    bool SpawnQueued(const TaskSlice& slice);
+    Vector2 PickSpawnPoint();
+    BaseEnemy* CreateEnemy(int enemy_id, Vector2 spawn);
+    void Autosave();
     void CheckWaveStatus();
     void HandleCollisions();
     void CheckGameStatus();
     void HandlePauseMenu();
     void DrawPauseMenu();
+    void DrawOverlay(int world_width, int world_height);
+    void EmitDeathParticles(BaseEnemy* enemy);
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <raylib.h>
 #include <raymath.h>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <vector>
@@ -13,6 +14,9 @@
 #include "projectile.cpp"
 #include "TileMap.cpp"
 #include "SaveSystem.hpp"
+#include "highscore.hpp"
+#include "ParticleSystem.hpp"
+#include "FramePacer.hpp"
 
 #define GAME_SCENE_MUSIC "Assets/Audio/Music/symphony.ogg"
 
@@ -31,17 +35,31 @@ Level::Level(int starting_wave, int starting_health) :
     wave_delay(2.0f),
     wave_cleared(false),
     player(nullptr),
-    music_loaded(false),
+    resolution_scaler(FPS),
+    frame_work_start(0.0),
+    last_work_time(0.0f),
+    show_overlay(false),
+    autosave_timer(0.0f),
     continue_hover(false),
     main_menu_hover(false),
     should_exit_to_menu(false)
 {
     camera_view = {0};
     camera_view.offset = {WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2};
-    camera_view.zoom = 2.0f;
+    camera_view.zoom = LEVEL_VIEW_ZOOM;
+    world_target = { 0 };
+    world_destination = { 0 };
     
     continue_button = { WINDOW_WIDTH/2 - 100, WINDOW_HEIGHT/2 - 60, 200, 50 };
     main_menu_button = { WINDOW_WIDTH/2 - 100, WINDOW_HEIGHT/2 + 10, 200, 50 };
+
+    registry.AddDeathHook([this](BaseEnemy& enemy) { EmitDeathParticles(&enemy); });
+
+    pause_hint_text.Set("Press P to pause");
+    game_over_text.Set("GAME OVER");
+    paused_text.Set("PAUSED");
+    continue_text.Set("CONTINUE");
+    main_menu_text.Set("MAIN MENU");
 }
 
 Level::Level(int starting_wave) : Level(starting_wave, 100) {
@@ -56,32 +74,43 @@ Level::~Level() {
 
 void Level::Begin() {
     map.LoadTilemapData("TileInfo.txt");
-    
-    if (player) delete player;
-    player = new Player(map.playerPos, 15.0f, 150.0f, starting_player_health);
-    player->setTileMap(&map);
-    
-    camera_view.target = player->position;
-    camera_window = {player->position.x - 150, player->position.y - 150, 300.0f, 300.0f};
-    
-    SpawnWave(current_wave);
-    
-    std::cout << "Attempting to load game music" << std::endl;
-    game_music = LoadMusicStream(GAME_SCENE_MUSIC);
-    
-    if (game_music.ctxData != nullptr) {
-        std::cout << "Music loaded successfully" << std::endl;
-        music_loaded = true;
-        AudioManager::GetInstance()->SetCurrentMusic(game_music);
-        PlayMusicStream(game_music);
-    } else {
-        std::cerr << "Failed to load game music at path: " << GAME_SCENE_MUSIC << std::endl;
-        music_loaded = false;
+    registry.Reset();
+
+    bool resumed = false;
+    if (!resume_snapshot.empty()) {
+        auto resume_start = std::chrono::steady_clock::now();
+        resumed = LoadSnapshot(resume_snapshot);
+        double resume_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - resume_start).count();
+
+        if (resumed) {
+            std::cout << "Resumed wave " << current_wave << " from snapshot (" << resume_snapshot.size()
+                      << " bytes) in " << resume_ms << " ms" << std::endl;
+        }
+        resume_snapshot.clear();
+    }
+
+    if (!resumed) {
+        if (player) delete player;
+        player = new Player(map.playerPos, 15.0f, 150.0f, starting_player_health);
+        player->setTileMap(&map);
+
+        camera_view.target = player->position;
+        camera_window = {player->position.x - 150, player->position.y - 150, 300.0f, 300.0f};
+
+        SpawnWave(current_wave);
     }
+
+    autosave_timer = 0.0f;
+    SetupWorldTarget();
+    resolution_scaler.Reset();
+    ParticleSystem::GetInstance()->Load();
+    
+    AudioManager::GetInstance()->PlayMusic(GAME_SCENE_MUSIC);
     
     game_ongoing = true;
     
     SaveSystem::GetInstance()->SaveGame(current_wave, player->health);
+    Autosave();
 }
 
 void Level::End() {
@@ -94,27 +123,61 @@ void Level::End() {
         }
     }
     enemies.clear();
+    registry.Reset();
+    // The menu restarts this same Level, so nothing queued may outlive the run
+    wave_director.Clear();
+    wave_timer = 0.0f;
+    TaskScheduler::GetInstance()->Cancel(spawn_task);
+    spawn_task = TASK_NONE;
     
     if (player) {
         delete player;
         player = nullptr;
     }
-       
-    if (music_loaded && game_music.ctxData != nullptr) {
-        StopMusicStream(game_music);
-        UnloadMusicStream(game_music);
-        
-        game_music.ctxData = nullptr;
-        game_music.stream = {0};
-        game_music.frameCount = 0;
-        
-        music_loaded = false;
+
+    if (world_target.id != 0) {
+        UnloadRenderTexture(world_target);
+        world_target = { 0 };
     }
 
+    ParticleSystem::GetInstance()->Unload();
+    map.fog.Unload();
+
 
     std::cout << "Level::End() - Cleanup completed" << std::endl;
 }
 
+void Level::SetHordeMode(bool enabled) {
+    horde_mode = enabled;
+}
+
+void Level::SetRenderResolution(int width, int height) {
+    render_width = width > 0 ? width : LEVEL_RENDER_WIDTH;
+    render_height = height > 0 ? height : LEVEL_RENDER_HEIGHT;
+}
+
+void Level::SetupWorldTarget() {
+    if (world_target.id == 0 || world_target.texture.width != render_width ||
+        world_target.texture.height != render_height) {
+        if (world_target.id != 0) UnloadRenderTexture(world_target);
+        world_target = LoadRenderTexture(render_width, render_height);
+        SetTextureFilter(world_target.texture, TEXTURE_FILTER_POINT);
+    }
+
+    // Largest whole-number scale that fits, centered (letterboxed if the
+    // resolution doesn't divide the window evenly)
+    int scale = std::min(WINDOW_WIDTH / render_width, WINDOW_HEIGHT / render_height);
+    if (scale < 1) scale = 1;
+    world_destination = {
+        (float)(WINDOW_WIDTH - render_width * scale) / 2, (float)(WINDOW_HEIGHT - render_height * scale) / 2,
+        (float)(render_width * scale), (float)(render_height * scale)
+    };
+
+    // Same view as before, expressed in render target pixels
+    camera_view.offset = { render_width / 2.0f, render_height / 2.0f };
+    camera_view.zoom = LEVEL_VIEW_ZOOM * render_width / WINDOW_WIDTH;
+}
+
 void Level::MoveCamera(float delta_time) {
     if (!player) return;
     
@@ -150,60 +213,237 @@ void Level::MoveCamera(float delta_time) {
     }
 }
 
+// Queues the wave; SpawnQueued() brings it in over the next frames
 void Level::SpawnWave(int wave_num) {
-    for (auto* e : enemies) delete e;
-    enemies.clear();
+    if (!horde_mode) {
+        for (auto* e : enemies) delete e;
+        enemies.clear();
+        registry.ClearLive();
+        wave_director.Clear();
+    }
 
     int points = base_wave_points + wave_num * 3;
+    int queued = wave_director.QueueWave(points, [this]() { return PickSpawnPoint(); });
+    ScheduleSpawns();
 
-    while (points > 0) {
-        int type = GetRandomValue(0, 2); // 0 = Slime(2pts), 1 = Ghost(1pt), 2 = Bee(3pts)
-        int spawnLocation = GetRandomValue(0,2);
-        Vector2 spawn;
-
-        switch (spawnLocation) {
-            case 0:
-                spawn = {1220,180};
-                break;
-            case 1:
-                spawn = {1220,550};
-                break;
-            case 2:
-                spawn = {50,550};
-                break;
-        }
+    std::cout << "Wave " << wave_num << " queued " << queued << " enemies.\n";
+}
+
+// Somewhere the player can be reached from, out of view and not too close
+Vector2 Level::PickSpawnPoint() {
+    // World units on screen; the same at every render resolution, and right
+    // even before SetupWorldTarget() has set the zoom for wave 1
+    Vector2 view_size = { WINDOW_WIDTH / LEVEL_VIEW_ZOOM, WINDOW_HEIGHT / LEVEL_VIEW_ZOOM };
+    Rectangle view = { camera_view.target.x - view_size.x / 2, camera_view.target.y - view_size.y / 2,
+                       view_size.x, view_size.y };
+    Vector2 focus = player ? player->position : map.playerPos;
+
+    Vector2 spawn;
+    if (map.PickSpawnPoint(ENEMY_RADIUS, focus, view, SPAWN_MIN_PLAYER_DISTANCE, spawn)) {
+        return spawn;
+    }
+    // Small or crowded maps: settle for anywhere valid that isn't on the player
+    if (map.PickSpawnPoint(ENEMY_RADIUS, focus, { 0, 0, 0, 0 }, SPAWN_MIN_PLAYER_DISTANCE / 2, spawn)) {
+        return spawn;
+    }
+    return map.enemyPos;
+}
+
+void Level::ScheduleSpawns() {
+    TaskScheduler* scheduler = TaskScheduler::GetInstance();
+    if (!wave_director.HasPending() || scheduler->IsPending(spawn_task)) return;
+
+    spawn_task = scheduler->Submit("wave spawn", [this](const TaskSlice& slice) { return SpawnQueued(slice); },
+                                   TASK_PRIORITY_HIGH, WAVE_SPAWN_BUDGET_US);
+}
 
-        if (type == 0 && points >= 2) {
-            Slime* slime = new Slime(spawn, 50, 15, 100, 250, 15, 2);
-            slime->setTileMap(&map);
-            enemies.push_back(slime);
-            points -= 2;
-        } else if (type == 1 && points >= 1) {
-            Ghost* ghost = new Ghost(spawn, 50, 15, 100, 250, 15, 2);
-            ghost->setTileMap(&map);
-            enemies.push_back(ghost);
-            points -= 1;
-        } else if (type == 2 && points >= 3) {
-            Bee* bee = new Bee(spawn, 100, 15, 100, 250, 50, 2);
-            bee->setTileMap(&map);
-            enemies.push_back(bee);
-            points -= 3;
+// One frame's slice of the queue. Always spawns at least one so a slow
+// machine still makes progress; nothing arrives while paused.
+bool Level::SpawnQueued(const TaskSlice& slice) {
+    if (is_paused || !game_ongoing) return !wave_director.HasPending();
+
+    while (wave_director.HasPending()) {
+        WaveSpawn spawn = wave_director.TakeNext();
+        BaseEnemy* enemy = CreateEnemy(spawn.enemy_id, spawn.position);
+        if (enemy != nullptr) {
+            enemies.push_back(enemy);
+            registry.OnSpawn(enemy->enemyID);
         }
+        if (slice.Expired()) break;
+    }
+    return !wave_director.HasPending();
+}
+
+BaseEnemy* Level::CreateEnemy(int enemy_id, Vector2 spawn) {
+    BaseEnemy* enemy = nullptr;
+
+    switch (enemy_id) {
+        case ENEMY_SLIME:
+            enemy = new Slime(spawn, 50, ENEMY_RADIUS, 100, 250, 15, 2);
+            break;
+        case ENEMY_GHOST:
+            enemy = new Ghost(spawn, 50, ENEMY_RADIUS, 100, 250, 15, 2);
+            break;
+        case ENEMY_BEE:
+            enemy = new Bee(spawn, 100, ENEMY_RADIUS, 100, 250, 50, 2);
+            break;
+        default:
+            return nullptr;
     }
 
-    std::cout << "Wave " << wave_num << " spawned with " << enemies.size() << " enemies.\n";
+    enemy->setTileMap(&map);
+    return enemy;
 }
 
-void Level::CheckWaveStatus() {
-    wave_cleared = true;
-    
+std::string Level::SaveSnapshot() {
+    // raylib's generator state can't be read back, so reseed it here from
+    // itself and store the seed: a resumed run then rolls exactly what this
+    // one will from this point on
+    uint32_t seed = ((uint32_t)GetRandomValue(0, 0xFFFF) << 16) | (uint32_t)GetRandomValue(0, 0xFFFF);
+    SetRandomSeed(seed);
+
+    SnapshotWriter writer(256 + enemies.size() * 128 + player->projectiles.size() * 32 +
+                          map.fog.GetExplored().size() * sizeof(uint64_t));
+    writer.Header();
+
+    writer.Value(seed);
+    writer.Value(current_wave);
+    writer.Value(base_wave_points);
+    writer.Value(wave_timer);
+    writer.Value(wave_delay);
+    writer.Value(wave_cleared);
+    writer.Value(camera_view);
+    writer.Value(camera_window);
+    writer.Value(cam_drift);
+
+    const std::vector<uint64_t>& explored = map.fog.GetExplored();
+    uint32_t explored_words = (uint32_t)explored.size();
+    writer.Count(explored_words, sizeof(uint64_t));
+    for (uint64_t word : explored) writer.Value(word);
+
+    player->Snapshot(writer);
+
+    uint32_t enemy_count = (uint32_t)enemies.size();
+    writer.Count(enemy_count, sizeof(int));
     for (auto* enemy : enemies) {
-        if (enemy->active) {
-            wave_cleared = false;
-            break;
+        writer.Value(enemy->enemyID);
+        enemy->WriteSnapshot(writer);
+    }
+
+    wave_director.Snapshot(writer);
+
+    return std::move(writer.bytes);
+}
+
+bool Level::LoadSnapshot(const std::string& bytes) {
+    SnapshotReader reader(bytes);
+    if (!reader.Header()) {
+        std::cerr << "ERROR: Snapshot has an unknown format or version" << std::endl;
+        return false;
+    }
+
+    uint32_t seed;
+    int wave, base_points;
+    float timer, delay, drift;
+    bool cleared;
+    Camera2D camera;
+    Rectangle window;
+
+    reader.Value(seed);
+    reader.Value(wave);
+    reader.Value(base_points);
+    reader.Value(timer);
+    reader.Value(delay);
+    reader.Value(cleared);
+    reader.Value(camera);
+    reader.Value(window);
+    reader.Value(drift);
+
+    uint32_t explored_words = 0;
+    reader.Count(explored_words, sizeof(uint64_t));
+    std::vector<uint64_t> explored(explored_words);
+    for (uint64_t& word : explored) reader.Value(word);
+
+    // Build everything on the side so a bad snapshot can't leave half a level
+    Player* restored_player = new Player(map.playerPos, 15.0f, 150.0f, starting_player_health);
+    restored_player->setTileMap(&map);
+    restored_player->Snapshot(reader);
+
+    uint32_t enemy_count = 0;
+    reader.Count(enemy_count, sizeof(int));
+
+    std::vector<BaseEnemy*> restored_enemies;
+    restored_enemies.reserve(enemy_count);
+    for (uint32_t i = 0; i < enemy_count && !reader.Failed(); i++) {
+        int enemy_id;
+        reader.Value(enemy_id);
+
+        BaseEnemy* enemy = CreateEnemy(enemy_id, {0, 0});
+        if (enemy == nullptr) break;
+
+        enemy->ReadSnapshot(reader, restored_player);
+        restored_enemies.push_back(enemy);
+    }
+
+    WaveDirector restored_director;
+    restored_director.Snapshot(reader);
+
+    if (reader.Failed() || !reader.AtEnd() || restored_enemies.size() != enemy_count ||
+        explored.size() != map.fog.GetExplored().size()) {
+        std::cerr << "ERROR: Snapshot is corrupt, ignoring it" << std::endl;
+        for (auto* e : restored_enemies) delete e;
+        delete restored_player;
+        return false;
+    }
+
+    for (auto* e : enemies) delete e;
+    enemies = std::move(restored_enemies);
+    registry.ClearLive();
+    for (auto* e : enemies) {
+        if (e->active) registry.OnSpawn(e->enemyID);
+    }
+    wave_director = std::move(restored_director);
+    ScheduleSpawns();
+    if (player) delete player;
+    player = restored_player;
+
+    current_wave = wave;
+    base_wave_points = base_points;
+    wave_timer = timer;
+    wave_delay = delay;
+    wave_cleared = cleared;
+    camera_view = camera;
+    camera_window = window;
+    cam_drift = drift;
+    map.fog.SetExplored(std::move(explored));
+    crowd.Update(enemies);   // separation is derived from positions, so it isn't saved
+
+    SetRandomSeed(seed);
+    return true;
+}
+
+void Level::SetResumeSnapshot(std::string bytes) {
+    resume_snapshot = std::move(bytes);
+}
+
+void Level::Autosave() {
+    SaveSystem::GetInstance()->SaveSnapshot(SaveSnapshot());
+}
+
+void Level::CheckWaveStatus() {
+    if (horde_mode) {
+        wave_timer += GetFrameTime();
+        if (wave_timer >= HORDE_WAVE_INTERVAL &&
+            registry.GetLiveCount() + wave_director.GetPendingCount() < HORDE_MAX_ENEMIES) {
+            current_wave++;
+            SpawnWave(current_wave);
+            wave_timer = 0.0f;
         }
+        return;
     }
 
+    wave_cleared = !wave_director.HasPending() && registry.GetLiveCount() == 0;
+
     if (wave_cleared) {
         wave_timer += GetFrameTime();
         if (wave_timer >= wave_delay) {
@@ -213,6 +453,8 @@ void Level::CheckWaveStatus() {
             
             // Save the current wave and player health when a new wave starts
             SaveSystem::GetInstance()->SaveGame(current_wave, player->health);
+            Autosave();
+            autosave_timer = 0.0f;
             std::cout << "Wave " << current_wave << " started - saved game with health " << player->health << std::endl;
         }
     }
@@ -232,6 +474,8 @@ void Level::CheckGameStatus() {
         game_ongoing = false;
         
         SaveSystem::GetInstance()->SaveGame(1, 100);
+        SaveSystem::GetInstance()->ClearSnapshot();
+        HighScoreManager::GetInstance()->AddHighScore("PLAYER", current_wave);
         
         SceneManager* sceneManager = GetSceneManager();
         if (sceneManager) {
@@ -258,16 +502,17 @@ void Level::HandlePauseMenu() {
 
 void Level::Update() {
     float delta_time = GetFrameTime();
-    
-    if (IsKeyPressed(KEY_P)) {
-        is_paused = !is_paused;
+
+    resolution_scaler.Update(delta_time, last_work_time, GetTime());
+    frame_work_start = GetTime();
+
+    const InputSnapshot& input = InputSystem::GetInstance()->Get();
+    if (input.Pressed(ACTION_OVERLAY)) {
+        show_overlay = !show_overlay;
     }
     
-    if (music_loaded && IsMusicReady(game_music)) {
-        UpdateMusicStream(game_music);
-        if (!IsMusicStreamPlaying(game_music)) {
-            PlayMusicStream(game_music);
-        }
+    if (input.Pressed(ACTION_PAUSE)) {
+        is_paused = !is_paused;
     }
 
     if (is_paused) {
@@ -277,12 +522,30 @@ void Level::Update() {
 
     if (game_ongoing) {
         player->Update(delta_time);
-        
+        map.fog.Update(player->position);
+
+        // Wakes only the enemy behaviors whose delay is up
+        BehaviorScheduler::GetInstance()->Advance(delta_time);
+
         for (auto* enemy : enemies) {
             if (enemy->active) {
                 enemy->Update(delta_time);
+                if (!enemy->active) registry.OnDeath(*enemy, enemy->enemyID);
+            }
+        }
+
+        // Drop the dead right away so long horde runs don't pile them up
+        size_t alive = 0;
+        for (auto* enemy : enemies) {
+            if (enemy->active) {
+                enemies[alive++] = enemy;
+            } else {
+                delete enemy;
             }
         }
+        enemies.resize(alive);
+        crowd.Update(enemies);
+        ParticleSystem::GetInstance()->Update(delta_time);
         
         HandleCollisions();
         
@@ -291,6 +554,12 @@ void Level::Update() {
         CheckGameStatus();
 
         MoveCamera(delta_time);
+
+        autosave_timer += delta_time;
+        if (game_ongoing && autosave_timer >= AUTOSAVE_INTERVAL) {
+            Autosave();
+            autosave_timer = 0.0f;
+        }
     }
     
     if (should_exit_to_menu) {
@@ -299,6 +568,7 @@ void Level::Update() {
         
         SaveData currentSave = SaveSystem::GetInstance()->LoadGame();
         SaveSystem::GetInstance()->SaveGame(current_wave, currentSave.playerHealth); //Save wave, not health
+        Autosave(); // Continue picks up exactly here
         
         SceneManager* sceneManager = GetSceneManager();
         if (sceneManager) {
@@ -307,33 +577,50 @@ void Level::Update() {
     }
 }
 
+void Level::EmitDeathParticles(BaseEnemy* enemy) {
+    ParticleSystem* particles = ParticleSystem::GetInstance();
+    if (enemy->enemyID == ENEMY_SLIME) {
+        particles->Emit(PARTICLE_SPLAT, enemy->position, 1, PARTICLE_SLIME_SPLAT, enemy->direction);
+        particles->Emit(PARTICLE_SPARK, enemy->position, 24, PARTICLE_SLIME_DROPLETS);
+    } else {
+        particles->Emit(PARTICLE_SPARK, enemy->position, 16, PARTICLE_DEATH_PUFF);
+    }
+}
+
 void Level::DrawPauseMenu() {
     DrawRectangle(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, Fade(WHITE, 0.7f));
     
-    DrawText("PAUSED", WINDOW_WIDTH/2 - MeasureText("PAUSED", 60)/2, WINDOW_HEIGHT/2 - 150, 60, MAROON);
+    paused_text.Draw(WINDOW_WIDTH/2 - (int)paused_text.GetWidth()/2, WINDOW_HEIGHT/2 - 150, MAROON);
     
     Color continue_color = continue_hover ? MAROON : RED;
     DrawRectangleRec(continue_button, continue_color);
     DrawRectangleLinesEx(continue_button, 2, MAROON);
-    DrawText("CONTINUE", 
-             continue_button.x + continue_button.width/2 - MeasureText("CONTINUE", 20)/2, 
-             continue_button.y + continue_button.height/2 - 10, 
-             20, WHITE);
+    continue_text.DrawCentered(continue_button, WHITE);
     
     Color menu_color = main_menu_hover ? MAROON : RED;
     DrawRectangleRec(main_menu_button, menu_color);
     DrawRectangleLinesEx(main_menu_button, 2, MAROON);
-    DrawText("MAIN MENU", 
-             main_menu_button.x + main_menu_button.width/2 - MeasureText("MAIN MENU", 20)/2, 
-             main_menu_button.y + main_menu_button.height/2 - 10, 
-             20, WHITE);
+    main_menu_text.DrawCentered(main_menu_button, WHITE);
 }
 
 void Level::Draw() {
     ClearBackground(BLACK);
     
     if (game_ongoing) {
-        BeginMode2D(camera_view);
+        // Dynamic resolution draws into the top-left part of the target only,
+        // so changing the scale never reallocates anything
+        float scale = resolution_scaler.GetScale();
+        int world_width = (int)(render_width * scale);
+        int world_height = (int)(render_height * scale);
+
+        Camera2D camera = camera_view;
+        camera.offset = { world_width / 2.0f, world_height / 2.0f };
+        camera.zoom = camera_view.zoom * world_width / render_width;
+
+        BeginTextureMode(world_target);
+        BeginScissorMode(0, 0, world_width, world_height);
+        ClearBackground(BLACK);
+        BeginMode2D(camera);
 
         map.DrawTilemap();
         
@@ -344,19 +631,66 @@ void Level::Draw() {
                 enemy->Draw();
             }
         }
+
+        ParticleSystem::GetInstance()->Draw();
+
+        map.fog.Draw();
         
         EndMode2D();
+        EndScissorMode();
+        EndTextureMode();
+
+        // Render textures are stored upside down, so the drawn region is
+        // the bottom rows of the texture
+        DrawTexturePro(world_target.texture,
+                       {0, (float)(render_height - world_height), (float)world_width, -(float)world_height},
+                       world_destination, {0, 0}, 0.0f, WHITE);
         
-        DrawText(TextFormat("Health: %d", player->health), 10, 10, 30, WHITE);
-        DrawText(TextFormat("Wave: %d", current_wave), 10, 50, 30, YELLOW);
-        DrawText(TextFormat("Position: %.0f %.0f", player->position.x, player->position.y), 10, 80, 30, YELLOW);
+        health_text.Set("Health: %d", player->health);
+        wave_text.Set("Wave: %d", current_wave);
+        position_text.Set("Position: %d %d", (int)roundf(player->position.x), (int)roundf(player->position.y));
+        enemies_text.Set("Enemies: %d", registry.GetLiveCount() + wave_director.GetPendingCount());
+
+        health_text.Draw(10, 10, WHITE);
+        wave_text.Draw(10, 50, YELLOW);
+        position_text.Draw(10, 80, YELLOW);
+        enemies_text.Draw(10, 110, YELLOW);
         
-        DrawText("Press P to pause", WINDOW_WIDTH - 200, 10, 20, WHITE);
+        pause_hint_text.Draw(WINDOW_WIDTH - 200, 10, WHITE);
         
+        if (show_overlay) {
+            DrawOverlay(world_width, world_height);
+        }
+
         if (is_paused) {
             DrawPauseMenu();
         }
     } else {
-        DrawText("GAME OVER", WINDOW_WIDTH / 4, WINDOW_HEIGHT / 2 - 25, 100, RED);
+        game_over_text.Draw(WINDOW_WIDTH / 4, WINDOW_HEIGHT / 2 - 25, RED);
+    }
+
+    last_work_time = (float)(GetTime() - frame_work_start);
+}
+
+void Level::DrawOverlay(int world_width, int world_height) {
+    int x = 10;
+    int y = WINDOW_HEIGHT - 200;
+    DrawRectangle(x - 5, y - 5, 470, 200, Fade(BLACK, 0.6f));
+
+    DrawText(TextFormat("FPS %d  frame %.1f ms  level %.1f ms", GetFPS(),
+                        resolution_scaler.GetAverageFrame() * 1000.0f,
+                        resolution_scaler.GetAverageWork() * 1000.0f), x, y, 20, GREEN);
+    DrawText(TextFormat("World %dx%d (%.0f%%)  raise after %.0f s", world_width, world_height,
+                        resolution_scaler.GetScale() * 100.0f, resolution_scaler.GetRaiseDelay()), x, y + 25, 20, GREEN);
+    const InputLatency& latency = InputSystem::GetInstance()->GetLatency();
+    DrawText(TextFormat("Input to present %.1f ms  (max %.1f)", latency.average_ms, latency.max_ms), x, y + 50, 20, GREEN);
+    FramePacingStats pacing = FramePacer::GetInstance()->GetStats();
+    DrawText(TextFormat("Pacing %.2f +- %.2f ms  1%% low %.1f ms", pacing.mean_ms, pacing.deviation_ms,
+                        pacing.one_percent_low_ms), x, y + 75, 20, GREEN);
+
+    for (int i = 0; i < DRS_HISTORY; i++) {
+        const ResolutionDecision* decision = resolution_scaler.GetDecision(i);
+        if (decision == nullptr) break;
+        DrawText(TextFormat("%5.1fs ago: %s", GetTime() - decision->time, decision->text), x, y + 100 + i * 22, 18, LIGHTGRAY);
     }
 }
\ No newline at end of file
@@ -16,13 +16,59 @@
 #include "death_scene-h.hpp"
 #include "leaderboard_scene-h.hpp"
 #include "level-h.hpp"
+#include "AssetPack.hpp"
+#include "SfxPool.hpp"
+#include "InputSystem.hpp"
+#include "FramePacer.hpp"
+#include "TaskScheduler.hpp"
+#include "highscore.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
+    auto startup_begin = std::chrono::steady_clock::now();
+
+    // ./out --render-resolution 320x180 --horde --present vsync|capped|uncapped --late-input
+    PresentMode present_mode = PRESENT_CAPPED;
+    bool late_input = false;
+    for (int i = 1; i < argc; i++) {
+        int width = 0, height = 0;
+        if (std::strcmp(argv[i], "--render-resolution") == 0 && i + 1 < argc &&
+            std::sscanf(argv[i + 1], "%dx%d", &width, &height) == 2) {
+            Level::SetRenderResolution(width, height);
+        } else if (std::strcmp(argv[i], "--horde") == 0) {
+            Level::SetHordeMode(true);
+        } else if (std::strcmp(argv[i], "--present") == 0 && i + 1 < argc) {
+            i++;
+            if (std::strcmp(argv[i], "vsync") == 0) present_mode = PRESENT_VSYNC;
+            else if (std::strcmp(argv[i], "uncapped") == 0) present_mode = PRESENT_UNCAPPED;
+            else present_mode = PRESENT_CAPPED;
+        } else if (std::strcmp(argv[i], "--late-input") == 0) {
+            late_input = true;
+        }
+    }
+
     InitAudioDevice();
+    AudioManager::GetInstance()->Init();
 
     InitWindow(1280, 720, "Final Project Mesa Reyes Ruiz");
-    SetTargetFPS(60);
+    FramePacer::GetInstance()->Configure(present_mode, 60.0, late_input);
+    InputSystem::GetInstance()->LoadBindings();
+
+    // The leaderboard reads and replays its files off the main thread; the
+    // first scene to ask for it before that finishes just waits for it
+    auto scores_start = std::chrono::steady_clock::now();
+    TaskScheduler::GetInstance()->RunInBackground("high scores", []() {
+        HighScoreManager::GetInstance();
+    }, [scores_start]() {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - scores_start).count();
+        std::cout << "High scores ready after " << ms << " ms" << std::endl;
+    }, TASK_PRIORITY_LOW);
+
+    AssetPack::GetInstance()->Open("assets.pak");
+    SfxPool::GetInstance()->Load();
 
     SceneManager scene_manager;
 
@@ -57,8 +103,13 @@ int main() {
 
     scene_manager.SwitchScene(0);
 
+    double startup_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup_begin).count();
+    std::cout << "Startup took " << startup_ms << " ms" << std::endl;
+
     while(!WindowShouldClose()) {
+        FramePacer::GetInstance()->BeginFrame();
         Scene* active_scene = scene_manager.GetActiveScene();
+        InputSystem::GetInstance()->Sample();
 
         if (active_scene != nullptr) {
             //std::cout << "Updating scene" << std::endl;
@@ -71,15 +122,34 @@ int main() {
         }
 
 
+        TaskScheduler::GetInstance()->RunFrame();
+
+        // Draw whatever Update() left active, not a scene it just ended
+        active_scene = scene_manager.GetActiveScene();
+
         BeginDrawing();
         ClearBackground(WHITE);
 
+        bool idle = false;
         if (active_scene != nullptr) {
             //std::cout << "Drawing scene" << std::endl;
-            active_scene->Draw();
+            idle = scene_manager.DrawScene(active_scene);
+        }
+
+        // An idle static scene blocks in EndDrawing() until the next input
+        // event instead of polling at 60 FPS (music streams on its own thread),
+        // unless there is scheduled work to finish
+        if (TaskScheduler::GetInstance()->HasWork()) idle = false;
+        if (idle) {
+            EnableEventWaiting();
+        } else {
+            DisableEventWaiting();
         }
 
+        FramePacer::GetInstance()->BeforePresent();
         EndDrawing();
+        InputSystem::GetInstance()->OnPresent();
+        FramePacer::GetInstance()->OnPresent(idle);
     }
 
     Scene* active_scene = scene_manager.GetActiveScene();
@@ -88,7 +158,20 @@ int main() {
         active_scene->End();
     }
 
-    ResourceManager::GetInstance()->UnloadAllTextures();
+    FramePacer::GetInstance()->PrintStats();
+    TaskScheduler::GetInstance()->Shutdown();
+    BehaviorFramePool::GetInstance()->PrintStats();
+
+    ResidencyStats residency = ResourceManager::GetInstance()->GetResidencyStats();
+    std::cout << "Texture residency: " << residency.bytes_resident << " of " << residency.budget << " bytes, "
+              << residency.hits << " hits, " << residency.misses << " misses, "
+              << residency.evictions << " evictions" << std::endl;
+
+    scene_manager.UnloadFrameCache();
+    SaveSystem::GetInstance()->Shutdown();
+    AudioManager::GetInstance()->Shutdown();
+    SfxPool::GetInstance()->Unload();
+    ResourceManager::GetInstance()->UnloadAll();
     
     CloseAudioDevice();
 
@@ -6,10 +6,11 @@
 MenuButton::MenuButton(Rectangle bounds, const char* text, Color normalColor, 
                        Color hoverColor, Color textColor, 
                        std::function<void()> action)
-    : text(text), normalColor(normalColor), hoverColor(hoverColor), 
+    : normalColor(normalColor), hoverColor(hoverColor), 
       textColor(textColor), action(action)
 {
     this->bounds = bounds;
+    label.Set(text);
 }
 
 bool MenuButton::HandleClick(Vector2 click_position) 
@@ -27,6 +28,7 @@ bool MenuButton::HandleClick(Vector2 click_position)
 }
 
 MainMenu::MainMenu() {
+    draws_on_demand = true;
     InitializeButtons();
 }
 
@@ -53,6 +55,11 @@ void MainMenu::InitializeButtons() {
                     
                     Level* level_scene = new Level(saveData.wave, saveData.playerHealth);
                     level_scene->SetSceneManager(sceneManager);
+
+                    std::string snapshot;
+                    if (SaveSystem::GetInstance()->LoadSnapshot(snapshot)) {
+                        level_scene->SetResumeSnapshot(std::move(snapshot));
+                    }
                     
                     sceneManager->UnregisterScene(6);
                     sceneManager->RegisterScene(level_scene, 6);
@@ -205,36 +212,14 @@ void MainMenu::Begin() {
         InitializeButtons();
     }
 
-    // Safely load music
-    try {
-        std::cout << "Checking if menu theme is already loaded" << std::endl;
-        if (menu_theme.ctxData == nullptr) {
-            std::cout << "Loading menu theme music" << std::endl;
-            menu_theme = LoadMusicStream("menu_theme.ogg");
-        }
-        
-        if (menu_theme.ctxData != nullptr) {
-            std::cout << "Menu theme loaded successfully" << std::endl;
-            musicLoaded = true;
-            AudioManager::GetInstance()->SetCurrentMusic(menu_theme);
-            PlayMusicStream(menu_theme);
-        } else {
-            std::cerr << "Failed to load menu theme music" << std::endl;
-            musicLoaded = false;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Exception loading music: " << e.what() << std::endl;
-        musicLoaded = false;
-    } catch (...) {
-        std::cerr << "Unknown exception loading music" << std::endl;
-        musicLoaded = false;
-    }
+    AudioManager::GetInstance()->PlayMusic("menu_theme.ogg");
 
     // Safely load background texture
     try {
         std::cout << "Loading background texture" << std::endl;
-        TextureData backgroundTextureData = ResourceManager::GetInstance()->GetTexture("back_cave.png");
-        backgroundTexture = backgroundTextureData.texture;
+        ResourceManager* resources = ResourceManager::GetInstance();
+        background_handle = resources->AcquireTexture("back_cave.png");
+        backgroundTexture = resources->GetTexture(background_handle).texture;
         std::cout << "Background texture loaded, ID: " << backgroundTexture.id << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Exception loading background: " << e.what() << std::endl;
@@ -246,14 +231,7 @@ void MainMenu::Begin() {
 }
 
 void MainMenu::End() {
-    if (IsMusicReady(menu_theme)) {
-        StopMusicStream(menu_theme);
-        UnloadMusicStream(menu_theme);
-        
-        menu_theme = {0};
-        musicLoaded = false;
-    }
-
+    ResourceManager::GetInstance()->Release(background_handle);
 }
 
 MainMenu::~MainMenu() {
@@ -269,16 +247,9 @@ void MainMenu::Update() {
     // Safely iterate through buttons
     for (auto& button : buttons) {
         if (button != nullptr) {
+            bool was_hovered = button->IsHovered();
             button->HandleClick(mousePoint);
-        }
-    }
-
-    // Safely update music
-    if (musicLoaded && menu_theme.ctxData != nullptr) {
-        UpdateMusicStream(menu_theme);
-
-        if (!IsMusicStreamPlaying(menu_theme)) {
-            PlayMusicStream(menu_theme);
+            if (button->IsHovered() != was_hovered) MarkDirty();
         }
     }
 }
@@ -290,11 +261,7 @@ void MenuButton::Draw()
     DrawRectangleRec(bounds, buttonColor);
     DrawRectangleLinesEx(bounds, 2, MAROON);
     
-    DrawText(text, 
-             bounds.x + bounds.width/2 - MeasureText(text, 20)/2, 
-             bounds.y + bounds.height/2 - 10, 
-             20, 
-             textColor);
+    label.DrawCentered(bounds, textColor);
 }
 
 void MainMenu::Draw() {
@@ -6,6 +6,7 @@
 #include <functional>
 #include "scene_manager.hpp"
 #include "level-h.hpp"
+#include "TextCache.hpp"
 
 // Forward declaration
 class MenuButton;
@@ -15,6 +16,7 @@ struct UIComponent {
     Rectangle bounds;
     virtual void Draw() = 0;
     virtual bool HandleClick(Vector2 click_position) = 0;
+    virtual bool IsHovered() const { return false; }
     virtual ~UIComponent() = default;
 };
 
@@ -31,8 +33,7 @@ public:
 private:
     std::vector<UIComponent*> buttons;
     Texture backgroundTexture;
-    Music menu_theme = {0};
-    bool musicLoaded = false;
+    ResourceHandle background_handle;
 
     void InitializeButtons();
 };
@@ -46,9 +47,10 @@ public:
 
     void Draw() override;
     bool HandleClick(Vector2 click_position) override;
+    bool IsHovered() const override { return isHovered; }
 
 private:
-    const char* text;
+    CachedText label{20};
     Color normalColor;
     Color hoverColor;
     Color textColor;
@@ -0,0 +1,126 @@
+// Builds assets.pak from the list of files in assets.txt.
+//
+//   ./pack_assets assets.txt assets.pak
+//
+// Every line of the list is a path exactly as the game asks for it
+// (bare filenames and Assets/ paths alike). Blank lines and lines
+// starting with '#' are skipped.
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetPack.hpp"
+
+struct PackInput {
+    std::string name;
+    std::vector<unsigned char> data;
+    uint64_t hash;
+};
+
+static bool ReadFile(const std::string& path, std::vector<unsigned char>& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    std::streamsize length = file.tellg();
+    file.seekg(0);
+    out.resize((size_t)length);
+    return length == 0 || (bool)file.read((char*)out.data(), length);
+}
+
+static uint64_t AlignUp(uint64_t value) {
+    return (value + PACK_ALIGNMENT - 1) & ~(uint64_t)(PACK_ALIGNMENT - 1);
+}
+
+int main(int argc, char** argv) {
+    std::string list_path = argc > 1 ? argv[1] : "assets.txt";
+    std::string pack_path = argc > 2 ? argv[2] : "assets.pak";
+
+    std::ifstream list(list_path);
+    if (!list.is_open()) {
+        std::cerr << "ERROR: Could not open asset list " << list_path << std::endl;
+        return 1;
+    }
+
+    std::vector<PackInput> inputs;
+    std::string line;
+    while (std::getline(list, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        PackInput input;
+        input.name = line;
+        if (!ReadFile(line, input.data)) {
+            std::cerr << "ERROR: Could not read " << line << std::endl;
+            return 1;
+        }
+        input.hash = HashAssetBytes(input.data.data(), input.data.size());
+        inputs.push_back(std::move(input));
+    }
+
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = PACK_VERSION;
+    header.entry_count = (uint32_t)inputs.size();
+    header.name_table_size = 0;
+
+    std::vector<PackEntry> entries(inputs.size());
+    std::string names;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        entries[i].name_offset = (uint32_t)names.size();
+        entries[i].name_length = (uint32_t)inputs[i].name.size();
+        names += inputs[i].name;
+    }
+    header.name_table_size = (uint32_t)names.size();
+
+    // Lay out blobs, sharing storage between byte-identical files
+    uint64_t cursor = AlignUp(sizeof(PackHeader) + entries.size() * sizeof(PackEntry) + names.size());
+    std::unordered_map<uint64_t, size_t> first_with_hash;
+    std::vector<bool> owns_blob(inputs.size(), false);
+    uint64_t shared_bytes = 0;
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        entries[i].size = inputs[i].data.size();
+        entries[i].hash = inputs[i].hash;
+
+        auto it = first_with_hash.find(inputs[i].hash);
+        if (it != first_with_hash.end() && inputs[it->second].data == inputs[i].data) {
+            entries[i].offset = entries[it->second].offset;
+            shared_bytes += inputs[i].data.size();
+            continue;
+        }
+
+        first_with_hash[inputs[i].hash] = i;
+        owns_blob[i] = true;
+        entries[i].offset = cursor;
+        cursor = AlignUp(cursor + inputs[i].data.size());
+    }
+
+    std::ofstream pack(pack_path, std::ios::binary | std::ios::trunc);
+    if (!pack.is_open()) {
+        std::cerr << "ERROR: Could not write " << pack_path << std::endl;
+        return 1;
+    }
+
+    pack.write((const char*)&header, sizeof(header));
+    pack.write((const char*)entries.data(), entries.size() * sizeof(PackEntry));
+    pack.write(names.data(), names.size());
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (!owns_blob[i]) continue;
+
+        uint64_t position = (uint64_t)pack.tellp();
+        std::vector<char> padding(entries[i].offset - position, 0);
+        pack.write(padding.data(), padding.size());
+        pack.write((const char*)inputs[i].data.data(), inputs[i].data.size());
+    }
+
+    pack.close();
+
+    std::cout << "Packed " << inputs.size() << " assets into " << pack_path
+              << " (" << cursor << " bytes, " << shared_bytes << " bytes deduplicated)" << std::endl;
+    return 0;
+}
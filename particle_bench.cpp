@@ -0,0 +1,84 @@
+// Keeps 100k particles alive and times the update and the CPU side of the
+// draw (packing instances, uploading them and submitting the draw calls).
+//
+//   ./particle_bench [particle count] [frames]
+//
+// Needs a (hidden) window for the GL context.
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "ParticleSystem.hpp"
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int target = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int frames = argc > 2 ? std::stoi(argv[2]) : 300;
+    const float delta_time = 1.0f / 60.0f;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(640, 360, "particle_bench");
+
+    ParticleSystem* particles = ParticleSystem::GetInstance();
+    particles->Load();
+
+    // Long lived sparks so the pools stay full; a few splats and trails
+    // so every pool takes part
+    ParticleBurst burst = PARTICLE_HIT_SPARKS;
+    burst.life_min = 2.0f;
+    burst.life_max = 4.0f;
+    Vector2 center = { 320, 180 };
+
+    Camera2D camera = { { 320, 180 }, center, 0.0f, 1.0f };
+    double update_ms = 0.0, draw_ms = 0.0;
+    int measured = 0;
+    long long live_total = 0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        int missing = target - particles->GetLiveCount();
+        if (missing > 0) {
+            particles->Emit(PARTICLE_SPARK, center, missing * 7 / 8, burst);
+            particles->Emit(PARTICLE_TRAIL, center, missing / 8, PARTICLE_PROJECTILE_TRAIL);
+            particles->Emit(PARTICLE_SPLAT, center, 1, PARTICLE_SLIME_SPLAT);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        particles->Update(delta_time);
+        double update = MillisecondsSince(start);
+
+        BeginDrawing();
+        ClearBackground(BLACK);
+        BeginMode2D(camera);
+        start = std::chrono::steady_clock::now();
+        particles->Draw();
+        rlDrawRenderBatchActive();
+        double draw = MillisecondsSince(start);
+        EndMode2D();
+        EndDrawing();
+
+        // The first second fills the pools
+        if (frame >= 60) {
+            update_ms += update;
+            draw_ms += draw;
+            live_total += particles->GetLiveCount();
+            measured++;
+        }
+    }
+
+    if (measured > 0) {
+        std::cout << live_total / measured << " live particles on average: update " << update_ms / measured
+                  << " ms, pack + submit " << draw_ms / measured << " ms per frame" << std::endl;
+    }
+
+    particles->Unload();
+    ResourceManager::GetInstance()->UnloadAll();
+    CloseWindow();
+    return 0;
+}
@@ -2,16 +2,29 @@
 #include <raymath.h>
 
 #include "projectile.hpp"
+#include "ParticleSystem.hpp"
 #define GAME_SCENE_EYEBALL_PROJECTILE "Assets/Texture/orb.png"
 
 void Projectile::Update(float delta_time) {
+    if (!active) return;
+
     position = Vector2Add(position, Vector2Scale(velocity, delta_time));
     if (position.x < 0 || position.x > GetScreenWidth() ||
         position.y < 0 || position.y > GetScreenHeight()) {
         active = false;
     }
+    if (active) {
+        ParticleSystem::GetInstance()->Emit(PARTICLE_TRAIL, position, 1, PARTICLE_PROJECTILE_TRAIL);
+    }
 };
 
+// Stops at the wall instead of passing through it
+void Projectile::HitWall(Vector2 point) {
+    position = point;
+    active = false;
+    ParticleSystem::GetInstance()->Emit(PARTICLE_SPARK, point, 6, PARTICLE_HIT_SPARKS);
+}
+
 void Projectile::Draw() {
     if (!active) return;
 
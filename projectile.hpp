@@ -17,6 +17,7 @@ public:
     Projectile(Vector2 pos, Vector2 vel, float r, Texture2D orb, Color col);
 
     void Update(float dt);
+    void HitWall(Vector2 point);
     void Draw();
 };
 
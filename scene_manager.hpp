@@ -3,9 +3,17 @@
 
 #include <raylib.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+#include "AssetPack.hpp"
+#include "TextureCache.hpp"
 
 class SceneManager;
 
@@ -37,6 +45,31 @@ public:
     SceneManager* GetSceneManager() {
         return scene_manager;
     }
+
+    // Asks for the next frame to be drawn again (only matters for scenes
+    // that draw on demand)
+    void MarkDirty() {
+        dirty = true;
+    }
+
+    bool DrawsOnDemand() const {
+        return draws_on_demand;
+    }
+
+    bool TakeDirty() {
+        bool was_dirty = dirty;
+        dirty = false;
+        return was_dirty;
+    }
+
+protected:
+    // Static scenes (menus) set this and call MarkDirty() whenever input,
+    // a hover change or an animation changes what they draw. Everything in
+    // between re-presents the last frame, see SceneManager::DrawScene().
+    bool draws_on_demand = false;
+
+private:
+    bool dirty = true;
 };
 
 class SceneManager {
@@ -89,6 +122,7 @@ public:
         active_scene = new_scene;
 
         std::cout << "Beginning new scene" << std::endl;
+        active_scene->MarkDirty();
         active_scene->Begin();
 
         std::cout << "Successfully switched to scene " << scene_id << std::endl;
@@ -124,7 +158,54 @@ public:
         return shouldExit;
     }
 
+    // Draws 'scene' between BeginDrawing/EndDrawing. A scene that draws on
+    // demand is only drawn when dirty, into a cached frame that is then
+    // presented as a single quad until it changes again. Returns true when
+    // nothing changed, i.e. the loop can sleep until the next input event.
+    bool DrawScene(Scene* scene) {
+        if (!scene->DrawsOnDemand()) {
+            scene->Draw();
+            return false;
+        }
+
+        int width = GetScreenWidth();
+        int height = GetScreenHeight();
+        if (frame_cache.id == 0 || frame_cache.texture.width != width || frame_cache.texture.height != height) {
+            if (frame_cache.id != 0) UnloadRenderTexture(frame_cache);
+            frame_cache = LoadRenderTexture(width, height);
+            scene->MarkDirty();
+        }
+
+        bool dirty = scene->TakeDirty();
+        if (dirty) {
+            BeginTextureMode(frame_cache);
+            scene->Draw();
+            EndTextureMode();
+            cached_redraws++;
+        }
+        cached_frames++;
+
+        // Render textures are stored upside down
+        DrawTextureRec(frame_cache.texture, {0, 0, (float)width, -(float)height}, {0, 0}, WHITE);
+        return !dirty;
+    }
+
+    void UnloadFrameCache() {
+        if (frame_cache.id != 0) {
+            UnloadRenderTexture(frame_cache);
+            frame_cache = { 0 };
+        }
+        if (cached_frames > 0) {
+            std::cout << "Static scenes redrew " << cached_redraws << " of " << cached_frames << " frames" << std::endl;
+        }
+    }
+
     bool shouldExit = false;
+
+private:
+    RenderTexture2D frame_cache = { 0 };
+    uint64_t cached_frames = 0;
+    uint64_t cached_redraws = 0;
 };
 
 //--------------------------------------
@@ -135,13 +216,63 @@ struct TextureData {
     int height;
 };
 
+enum class ResourceType {
+    TEXTURE,
+    SOUND,
+    MUSIC
+};
+
+// Compact reference into the ResourceManager slot array.
+// The generation is bumped every time a slot is freed, so a handle that
+// outlives its resource is detected instead of aliasing a newer one.
+struct ResourceHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+#define RESOURCE_NONE UINT32_MAX
+#define DEFAULT_TEXTURE_BUDGET (256u * 1024u * 1024u)
+
+struct ResourceSlot {
+    std::string path;
+    ResourceType type = ResourceType::TEXTURE;
+    uint32_t generation = 0;
+    int references = 0;
+    bool active = false;
+
+    // Textures stay resident after their last release until the budget
+    // needs the memory back, and reload themselves on the next use.
+    bool resident = false;
+    size_t bytes = 0;
+    uint32_t lru_prev = RESOURCE_NONE;
+    uint32_t lru_next = RESOURCE_NONE;
+
+    TextureData texture = {0};
+    Sound sound = {0};
+    Music music = {0};
+};
+
+struct ResidencyStats {
+    size_t bytes_resident;
+    size_t budget;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+};
+
 class ResourceManager {
-std::unordered_map<std::string, TextureData> textures; // Store TextureData
+    // Path -> slot index. Only touched when a resource is first acquired
+    // or finally released, never on per-frame lookups.
+    std::unordered_map<std::string, uint32_t> interned;
+    std::vector<ResourceSlot> slots;
+    std::vector<uint32_t> free_slots;
 
-    ResourceManager() {}
-private:
+    // Unreferenced resident textures, least recently released first
+    uint32_t lru_head = RESOURCE_NONE;
+    uint32_t lru_tail = RESOURCE_NONE;
+    ResidencyStats stats = {0, DEFAULT_TEXTURE_BUDGET, 0, 0, 0};
 
-    std::unordered_map<std::string, int> textureReferences;
+    ResourceManager() {}
 
 public:
     ResourceManager(const ResourceManager&) = delete;
@@ -152,80 +283,372 @@ public:
         return &instance;
     }
 
-    TextureData GetTexture(const std::string& path) {
+    ResourceHandle AcquireTexture(const std::string& path) {
+        return Acquire(path, ResourceType::TEXTURE);
+    }
+
+    ResourceHandle AcquireSound(const std::string& path) {
+        return Acquire(path, ResourceType::SOUND);
+    }
+
+    ResourceHandle AcquireMusic(const std::string& path) {
+        return Acquire(path, ResourceType::MUSIC);
+    }
+
+    // For resources shared by every instance of a class (enemy sprites, player sfx).
+    // The cached handle is interned once; later instances only bump the slot's
+    // reference count, so spawning never hashes the path again.
+    ResourceHandle AcquireShared(ResourceHandle& cached, const char* path, ResourceType type) {
+        if (!Retain(cached)) {
+            cached = Acquire(path, type);
+        }
+        return cached;
+    }
+
+    bool IsValid(ResourceHandle handle) const {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation &&
+               slots[handle.index].active;
+    }
+
+    bool Retain(ResourceHandle handle) {
+        if (!IsValid(handle)) return false;
+        RetainSlot(handle.index);
+        return true;
+    }
+
+    // Drops one reference and clears the caller's handle, so releasing
+    // twice (e.g. End() followed by a destructor) is harmless.
+    void Release(ResourceHandle& handle) {
+        if (!IsValid(handle)) return;
+
+        uint32_t index = handle.index;
+        handle = ResourceHandle{};
+
+        ResourceSlot& slot = slots[index];
+        if (slot.references <= 0) return;
+        slot.references--;
+        if (slot.references > 0) return;
+
+        if (slot.type == ResourceType::TEXTURE) {
+            // Keep it around for the next scene that wants it
+            LruPushBack(index);
+            EnforceBudget();
+            return;
+        }
+
+        UnloadSlot(slot);
+        FreeSlot(index);
+    }
+
+    // By value: 'slots' moves when Acquire() grows it
+    TextureData GetTexture(ResourceHandle handle) {
+        if (!IsValid(handle)) return TextureData{0};
+
+        ResourceSlot& slot = slots[handle.index];
+        if (!slot.resident) {
+            // Evicted while nobody held it; bring it back transparently.
+            // Still unreferenced, so it goes back on the eviction list.
+            stats.misses++;
+            LoadResident(slot);
+            if (slot.resident && slot.references == 0) LruPushBack(handle.index);
+            EnforceBudget();
+        }
+        return slot.texture;
+    }
+
+    Sound GetSound(ResourceHandle handle) const {
+        if (!IsValid(handle)) return Sound{0};
+        return slots[handle.index].sound;
+    }
+
+    Music GetMusic(ResourceHandle handle) const {
+        if (!IsValid(handle)) return Music{0};
+        return slots[handle.index].music;
+    }
+
+    // Caps how much texture memory unreferenced textures may keep resident.
+    // Referenced textures are never evicted, so the cap can be exceeded while
+    // a scene genuinely needs more.
+    void SetTextureBudget(size_t bytes) {
+        stats.budget = bytes;
+        EnforceBudget();
+    }
+
+    ResidencyStats GetResidencyStats() const {
+        return stats;
+    }
+
+    void UnloadAll() {
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].active) {
+                UnloadSlot(slots[i]);
+                FreeSlot(i);
+            }
+        }
+        interned.clear();
+        lru_head = RESOURCE_NONE;
+        lru_tail = RESOURCE_NONE;
+    }
+
+private:
+    ResourceHandle Acquire(const std::string& path, ResourceType type) {
         try {
-            // Check if the texture is already loaded
-            if (textures.find(path) != textures.end()) {
-                std::cout << "Resource Already Loaded: " << path << std::endl;
-                textureReferences[path]++;
-                return textures[path]; 
+            // Check if the resource is already loaded
+            auto it = interned.find(path);
+            if (it != interned.end()) {
+                ResourceSlot& slot = slots[it->second];
+                if (slot.type != type) {
+                    std::cerr << "ERROR: Resource " << path << " already loaded as another type" << std::endl;
+                    return ResourceHandle{};
+                }
+                RetainSlot(it->second);
+                return ResourceHandle{it->second, slot.generation};
+            }
+
+            std::cout << "Attempting to load resource: " << path << std::endl;
+
+            // Check the asset pack first, then loose files
+            if (!AssetPack::GetInstance()->Contains(path) && !FileExists(path.c_str())) {
+                std::cerr << "ERROR: Resource file does not exist: " << path << std::endl;
+                return ResourceHandle{};
+            }
+
+            ResourceSlot loaded;
+            loaded.path = path;
+            loaded.type = type;
+
+            if (!LoadSlot(loaded)) {
+                std::cerr << "Failed to load resource " << path << std::endl;
+                return ResourceHandle{};
             }
-    
-            std::cout << "Attempting to load texture: " << path << std::endl;
-            
-            // Check if file exists first
-            if (!FileExists(path.c_str())) {
-                std::cerr << "ERROR: Texture file does not exist: " << path << std::endl;
-                TextureData emptyData = {0};
-                return emptyData;
+
+            uint32_t index;
+            if (!free_slots.empty()) {
+                index = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                index = (uint32_t)slots.size();
+                slots.emplace_back();
             }
-    
-            // Load the texture
-            Texture texture = LoadTexture(path.c_str());
-    
-            // Error handling
-            if (texture.id == 0) {
-                std::cerr << "Failed to load texture " << path << std::endl;
-                TextureData emptyData = {0};
-                return emptyData;
+
+            loaded.generation = slots[index].generation;
+            loaded.references = 1;
+            loaded.active = true;
+            slots[index] = loaded;
+            interned[path] = index;
+
+            if (type == ResourceType::TEXTURE) {
+                stats.misses++;
+                stats.bytes_resident += loaded.bytes;
+                EnforceBudget();
             }
-    
-            std::cout << "Loaded " << path << " from Disk" << std::endl;
-            TextureData textureData;
-            textureData.texture = texture;
-            textureData.width = texture.width;
-            textureData.height = texture.height;
-            
-            textures[path] = textureData;
-            textureReferences[path] = 1;
-            return textureData;
+
+            std::cout << "Loaded " << path << (AssetPack::GetInstance()->Contains(path) ? " from Pack" : " from Disk") << std::endl;
+            return ResourceHandle{index, loaded.generation};
         }
         catch (const std::exception& e) {
-            std::cerr << "Exception in GetTexture: " << e.what() << std::endl;
-            TextureData emptyData = {0};
-            return emptyData;
+            std::cerr << "Exception in Acquire: " << e.what() << std::endl;
+            return ResourceHandle{};
         }
         catch (...) {
-            std::cerr << "Unknown exception in GetTexture" << std::endl;
-            TextureData emptyData = {0};
-            return emptyData;
+            std::cerr << "Unknown exception in Acquire" << std::endl;
+            return ResourceHandle{};
+        }
+    }
+
+    void RetainSlot(uint32_t index) {
+        ResourceSlot& slot = slots[index];
+        slot.references++;
+        if (slot.references > 1 || slot.type != ResourceType::TEXTURE) return;
+
+        if (slot.resident) {
+            LruRemove(index);
+            stats.hits++;
+        } else {
+            stats.misses++;
+            LoadResident(slot);
+            EnforceBudget();
+        }
+    }
+
+    // Callers fix up the LRU list and then call EnforceBudget()
+    void LoadResident(ResourceSlot& slot) {
+        std::cout << "Reloading evicted texture: " << slot.path << std::endl;
+        if (!LoadSlot(slot)) {
+            std::cerr << "Failed to reload resource " << slot.path << std::endl;
+            return;
         }
+        stats.bytes_resident += slot.bytes;
     }
 
-    void UnloadAllTextures() {
-        for (auto& it : textures) {
-            UnloadTexture(it.second.texture);
+    void EnforceBudget() {
+        while (stats.bytes_resident > stats.budget && lru_head != RESOURCE_NONE) {
+            uint32_t victim = lru_head;
+            ResourceSlot& slot = slots[victim];
+            LruRemove(victim);
+
+            UnloadTexture(slot.texture.texture);
+            slot.texture = {0};
+            slot.resident = false;
+            stats.bytes_resident -= slot.bytes;
+            stats.evictions++;
+            std::cout << "Evicted texture " << slot.path << " (" << slot.bytes << " bytes)" << std::endl;
         }
-        textures.clear();
     }
 
-    void UnloadTextures(const std::string& path) {
+    void LruPushBack(uint32_t index) {
+        ResourceSlot& slot = slots[index];
+        slot.lru_prev = lru_tail;
+        slot.lru_next = RESOURCE_NONE;
+        if (lru_tail != RESOURCE_NONE) slots[lru_tail].lru_next = index;
+        else lru_head = index;
+        lru_tail = index;
+    }
+
+    void LruRemove(uint32_t index) {
+        ResourceSlot& slot = slots[index];
+        if (slot.lru_prev != RESOURCE_NONE) slots[slot.lru_prev].lru_next = slot.lru_next;
+        else lru_head = slot.lru_next;
+        if (slot.lru_next != RESOURCE_NONE) slots[slot.lru_next].lru_prev = slot.lru_prev;
+        else lru_tail = slot.lru_prev;
+        slot.lru_prev = RESOURCE_NONE;
+        slot.lru_next = RESOURCE_NONE;
+    }
+
+    void FreeSlot(uint32_t index) {
+        ResourceSlot& slot = slots[index];
+        interned.erase(slot.path);
+        slot.path.clear();
+        slot.active = false;
+        slot.references = 0;
+        slot.generation++;
+        free_slots.push_back(index);
+    }
 
-        if (textureReferences.find(path) != textureReferences.end()) {
-            textureReferences[path]--;
-            
-            if (textureReferences[path] <= 0) {
-                UnloadTexture(textures[path].texture);
-                textures.erase(path);
-                textureReferences.erase(path);
+    bool LoadSlot(ResourceSlot& slot) {
+        // Packed assets are decoded straight out of the mapped archive
+        int packed_size = 0;
+        const unsigned char* packed = AssetPack::GetInstance()->GetData(slot.path, &packed_size);
+        const char* extension = GetFileExtension(slot.path.c_str());
+
+        switch (slot.type) {
+            case ResourceType::TEXTURE: {
+                uint64_t source_hash = 0;
+                unsigned char* loose = nullptr;
+                int loose_size = 0;
+                if (!TextureCache::SourceHash(slot.path, &source_hash, &loose, &loose_size)) return false;
+                if (loose != nullptr) {
+                    packed = loose;
+                    packed_size = loose_size;
+                }
+
+                // Prefer the cooked pixels when they were built from these exact bytes;
+                // a packed PNG is only touched if there is no matching cook
+                Image image = { 0 };
+                unsigned char* cooked = nullptr;
+                Texture texture;
+                if (TextureCache::LoadCookedImage(slot.path, source_hash, &image, &cooked)) {
+                    texture = LoadTextureFromImage(image);
+                    if (cooked != nullptr) UnloadFileData(cooked);
+                } else {
+                    image = LoadImageFromMemory(extension, packed, packed_size);
+                    texture = LoadTextureFromImage(image);
+                    UnloadImage(image);
+                }
+                if (loose != nullptr) UnloadFileData(loose);
+
+                if (texture.id == 0) return false;
+                slot.texture = {texture, texture.width, texture.height};
+                slot.bytes = (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+                slot.resident = true;
+                return true;
             }
+            case ResourceType::SOUND:
+                if (packed != nullptr) {
+                    Wave wave = LoadWaveFromMemory(extension, packed, packed_size);
+                    slot.sound = LoadSoundFromWave(wave);
+                    UnloadWave(wave);
+                } else {
+                    slot.sound = LoadSound(slot.path.c_str());
+                }
+                return IsSoundReady(slot.sound);
+            case ResourceType::MUSIC:
+                // The pack stays mapped for the whole run, so the stream can read from it directly
+                if (packed != nullptr) {
+                    slot.music = LoadMusicStreamFromMemory(extension, packed, packed_size);
+                } else {
+                    slot.music = LoadMusicStream(slot.path.c_str());
+                }
+                return IsMusicReady(slot.music);
         }
+        return false;
     }
 
+    void UnloadSlot(ResourceSlot& slot) {
+        switch (slot.type) {
+            case ResourceType::TEXTURE:
+                if (slot.resident) {
+                    UnloadTexture(slot.texture.texture);
+                    stats.bytes_resident -= slot.bytes;
+                }
+                slot.texture = {0};
+                slot.resident = false;
+                break;
+            case ResourceType::SOUND:
+                StopSound(slot.sound);
+                UnloadSound(slot.sound);
+                slot.sound = {0};
+                break;
+            case ResourceType::MUSIC:
+                StopMusicStream(slot.music);
+                UnloadMusicStream(slot.music);
+                slot.music = {0};
+                break;
+        }
+    }
 };
 
 //-------------------------
 
+// Music is streamed by its own thread, so the decode buffers are refilled on
+// time even when a frame runs long (scene loads, wave spawns). Scenes only
+// ask for a track with PlayMusic(); the manager owns the stream, looping and
+// the crossfade out of whatever was playing before.
+//
+// Only the main thread acquires, swaps or releases tracks. The streaming
+// thread touches the Music streams and fade gains, always under 'mutex'.
+//
+// Volume goes through mixer buses. Each bus gain is an atomic read by a
+// processor that raylib runs inside the audio callback: the master bus is
+// attached to the final mix, the others to every stream/voice routed to
+// them. Moving a slider is one store, and it reaches sounds already playing.
+
+enum AudioBus {
+    BUS_MASTER,
+    BUS_MUSIC,
+    BUS_SFX,
+    BUS_UI,
+    BUS_COUNT
+};
+
+// raylib mixes in interleaved stereo float
+#define AUDIO_MIX_CHANNELS 2
+
+#define MUSIC_STREAM_BUFFER_FRAMES 4096
+#define MUSIC_STREAM_INTERVAL_MS 5
+#define MUSIC_DEFAULT_FADE 0.75f
+
+struct MusicTrack {
+    ResourceHandle handle;
+    Music music = { 0 };
+    std::string path;
+    float fade = 0.0f;          // current gain, 0..1
+    float fade_speed = 0.0f;    // gain per second, negative while fading out
+    bool active = false;
+    bool finished = false;      // faded out and stopped, ready to release
+};
+
 class AudioManager {
 public:
     static AudioManager* GetInstance() {
@@ -233,35 +656,200 @@ public:
         return &instance;
     }
 
-    void SetMasterVolume(float volume) {
+    // Hooks the master bus into the mix. Call once after InitAudioDevice().
+    void Init() {
+        AttachAudioMixedProcessor(ApplyBusGain<BUS_MASTER>);
+    }
+
+    void SetBusVolume(AudioBus bus, float volume) {
         // Ensure volume is between 0.0 and 1.0
-        master_volume = std::clamp(volume, 0.0f, 1.0f);
-        
-        // Apply volume to all music and sound effects
-        SetMusicVolume(current_music, master_volume);
-        SetSoundVolume(all_sounds, master_volume);
+        bus_gains[bus].store(std::clamp(volume, 0.0f, 1.0f), std::memory_order_relaxed);
     }
 
-    float GetMasterVolume() const {
-        return master_volume;
+    float GetBusVolume(AudioBus bus) const {
+        return bus_gains[bus].load(std::memory_order_relaxed);
     }
 
-    void SetCurrentSound(Sound sound) {
-        all_sounds = sound;
-        SetSoundVolume(all_sounds, master_volume);
+    // Routes a stream (a music stream or a sound/alias's stream) through a
+    // bus. Detach before the stream is unloaded; raylib doesn't free it.
+    static void AttachToBus(AudioStream stream, AudioBus bus) {
+        AttachAudioStreamProcessor(stream, BusProcessor(bus));
     }
 
-    void SetCurrentMusic(Music music) {
-        current_music = music;
-        SetMusicVolume(current_music, master_volume);
+    static void DetachFromBus(AudioStream stream, AudioBus bus) {
+        DetachAudioStreamProcessor(stream, BusProcessor(bus));
+    }
+
+    // Crossfades to the track at 'path'. Asking for the track that is already
+    // playing does nothing, so scenes sharing a theme carry it over seamlessly.
+    void PlayMusic(const std::string& path, float fade_seconds = MUSIC_DEFAULT_FADE) {
+        ReapFinished();
+        if (current.active && current.path == path) return;
+
+        StartStreaming();
+
+        ResourceManager* resources = ResourceManager::GetInstance();
+        MusicTrack next;
+        next.path = path;
+        next.handle = resources->AcquireMusic(path);
+        next.music = resources->GetMusic(next.handle);
+        if (!IsMusicReady(next.music)) {
+            std::cerr << "Failed to load music " << path << std::endl;
+            resources->Release(next.handle);
+            return;
+        }
+        next.music.looping = true;
+        next.active = true;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        bool crossfade = current.active && fade_seconds > 0.0f;
+
+        RetireCurrent(fade_seconds);
+        next.fade = crossfade ? 0.0f : 1.0f;
+        next.fade_speed = crossfade ? 1.0f / fade_seconds : 0.0f;
+        current = next;
+
+        AttachToBus(current.music.stream, BUS_MUSIC);
+        SetMusicVolume(current.music, current.fade);
+        PlayMusicStream(current.music);
+    }
+
+    void StopMusic(float fade_seconds = MUSIC_DEFAULT_FADE) {
+        ReapFinished();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        RetireCurrent(fade_seconds);
+    }
+
+    // Joins the streaming thread and gives every track back. Call before
+    // ResourceManager::UnloadAll() and CloseAudioDevice().
+    void Shutdown() {
+        if (streaming.joinable()) {
+            running.store(false);
+            streaming.join();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        DropTrack(current);
+        DropTrack(fading);
+
+        DetachAudioMixedProcessor(ApplyBusGain<BUS_MASTER>);
     }
 
 private:
-    AudioManager() : master_volume(0.5f) {}  // Default 50% volume
-    
-    float master_volume;
-    Music current_music;
-    Sound all_sounds;
+    AudioManager() {
+        SetBusVolume(BUS_MASTER, 0.5f);  // Default 50% volume
+        SetBusVolume(BUS_MUSIC, 1.0f);
+        SetBusVolume(BUS_SFX, 1.0f);
+        SetBusVolume(BUS_UI, 1.0f);
+    }
+
+    // Runs on the audio thread for every block of a stream on this bus
+    template <int BUS>
+    static void ApplyBusGain(void* buffer, unsigned int frames) {
+        float gain = bus_gains[BUS].load(std::memory_order_relaxed);
+        if (gain == 1.0f) return;
+
+        float* samples = (float*)buffer;
+        unsigned int count = frames * AUDIO_MIX_CHANNELS;
+        for (unsigned int i = 0; i < count; i++) {
+            samples[i] *= gain;
+        }
+    }
+
+    static AudioCallback BusProcessor(AudioBus bus) {
+        switch (bus) {
+            case BUS_MUSIC: return ApplyBusGain<BUS_MUSIC>;
+            case BUS_SFX: return ApplyBusGain<BUS_SFX>;
+            case BUS_UI: return ApplyBusGain<BUS_UI>;
+            default: return ApplyBusGain<BUS_MASTER>;
+        }
+    }
+
+    void StartStreaming() {
+        if (streaming.joinable()) return;
+
+        // Bigger halves for the stream's double buffer: each refill now covers
+        // ~90 ms at 44.1 kHz instead of one device period
+        SetAudioStreamBufferSizeDefault(MUSIC_STREAM_BUFFER_FRAMES);
+
+        running.store(true);
+        streaming = std::thread([this]() { StreamLoop(); });
+    }
+
+    void StreamLoop() {
+        auto last = std::chrono::steady_clock::now();
+
+        while (running.load()) {
+            auto now = std::chrono::steady_clock::now();
+            float delta_time = std::chrono::duration<float>(now - last).count();
+            last = now;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                StreamTrack(current, delta_time);
+                StreamTrack(fading, delta_time);
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(MUSIC_STREAM_INTERVAL_MS));
+        }
+    }
+
+    void StreamTrack(MusicTrack& track, float delta_time) {
+        if (!track.active || track.finished) return;
+
+        track.fade = std::clamp(track.fade + track.fade_speed * delta_time, 0.0f, 1.0f);
+        if (track.fade_speed < 0.0f && track.fade <= 0.0f) {
+            StopMusicStream(track.music);
+            track.finished = true;
+            return;
+        }
+
+        SetMusicVolume(track.music, track.fade);
+        UpdateMusicStream(track.music);
+
+        if (!IsMusicStreamPlaying(track.music)) {
+            PlayMusicStream(track.music);
+        }
+    }
+
+    // Moves the current track into the fade-out slot, cutting whatever was
+    // still fading out. Must be called with 'mutex' held.
+    void RetireCurrent(float fade_seconds) {
+        DropTrack(fading);
+        if (!current.active) return;
+
+        if (fade_seconds > 0.0f) {
+            fading = current;
+            fading.fade_speed = -1.0f / fade_seconds;
+            current = MusicTrack();
+        } else {
+            DropTrack(current);
+        }
+    }
+
+    // Main thread only; the streaming thread never sees a dropped track again
+    void DropTrack(MusicTrack& track) {
+        if (!track.active) return;
+        if (!track.finished) StopMusicStream(track.music);
+        DetachFromBus(track.music.stream, BUS_MUSIC);
+        ResourceManager::GetInstance()->Release(track.handle);
+        track = MusicTrack();
+    }
+
+    void ReapFinished() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fading.finished) DropTrack(fading);
+    }
+
+    static inline std::atomic<float> bus_gains[BUS_COUNT];
+
+    std::mutex mutex;
+    std::thread streaming;
+    std::atomic<bool> running{ false };
+
+    MusicTrack current;
+    MusicTrack fading;
 };
 
 #endif
\ No newline at end of file
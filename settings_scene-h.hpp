@@ -43,8 +43,7 @@ private:
     std::vector<UIComponent*> uiElements;
     std::vector<MenuButton*> buttons;
     Texture settingsBackground;
-    Music menu_theme = {0};
-    bool musicLoaded = false;
+    ResourceHandle background_handle;
     VolumeSlider* masterVolumeSlider;
     VolumeSlider* musicVolumeSlider;
     VolumeSlider* sfxVolumeSlider;
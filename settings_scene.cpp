@@ -37,7 +37,7 @@ void SettingsScene::LoadSettings() {
             sfxVolumeSlider->SetValue(sfxVol);
             
             // Update volumes
-            AudioManager::GetInstance()->SetMasterVolume(masterVol);
+            UpdateVolumes();
             
             std::cout << "Settings loaded successfully" << std::endl;
         } else {
@@ -92,6 +92,7 @@ bool VolumeSlider::HandleClick(Vector2 click_position)
 }
 
 SettingsScene::SettingsScene() {
+    draws_on_demand = true;
     InitializeUI();
 }
 
@@ -102,11 +103,14 @@ void SettingsScene::InitializeUI() {
     }
     uiElements.clear();
 
+    // Sliders start where the buses are; LoadSettings() overrides both
+    AudioManager* audio = AudioManager::GetInstance();
+
     // Master Volume Slider
     masterVolumeSlider = new VolumeSlider(
         {500, 200, 300, 20}, 
         "Master Volume", 
-        0.5f  // Default value
+        audio->GetBusVolume(BUS_MASTER)
     );
     uiElements.push_back(masterVolumeSlider);
 
@@ -114,7 +118,7 @@ void SettingsScene::InitializeUI() {
     musicVolumeSlider = new VolumeSlider(
         {500, 300, 300, 20}, 
         "Music Volume", 
-        0.5f  // Default value, can be expanded to track music volume separately
+        audio->GetBusVolume(BUS_MUSIC)
     );
     uiElements.push_back(musicVolumeSlider);
 
@@ -122,7 +126,7 @@ void SettingsScene::InitializeUI() {
     sfxVolumeSlider = new VolumeSlider(
         {500, 400, 300, 20}, 
         "SFX Volume", 
-        0.5f  // Default value, can be expanded to track SFX volume separately
+        audio->GetBusVolume(BUS_SFX)
     );
     uiElements.push_back(sfxVolumeSlider);
 
@@ -154,32 +158,16 @@ void SettingsScene::Begin() {
     }
 
     // Load background texture
-    TextureData settingsBackgroundData = ResourceManager::GetInstance()->GetTexture("back_cave.png");
-    settingsBackground = settingsBackgroundData.texture;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    background_handle = resources->AcquireTexture("back_cave.png");
+    settingsBackground = resources->GetTexture(background_handle).texture;
 
-    if (!IsMusicReady(menu_theme)) {
-        menu_theme = LoadMusicStream("menu_theme.ogg");
-    }
-    
-    if (IsMusicReady(menu_theme)) {
-        musicLoaded = true;
-        AudioManager::GetInstance()->SetCurrentMusic(menu_theme);
-        PlayMusicStream(menu_theme);
-    } else {
-        std::cerr << "Failed to load menu theme music" << std::endl;
-    }
+    AudioManager::GetInstance()->PlayMusic("menu_theme.ogg");
 }
 
 void SettingsScene::End() {
     SaveSettings();
-
-    if (IsMusicReady(menu_theme)) {
-        StopMusicStream(menu_theme);
-        UnloadMusicStream(menu_theme);
-        
-        menu_theme = {0};
-        musicLoaded = false;
-    }
+    ResourceManager::GetInstance()->Release(background_handle);
 }
 
 SettingsScene::~SettingsScene() {
@@ -194,30 +182,27 @@ void SettingsScene::Update() {
     Vector2 mousePoint = GetMousePosition();
 
     // Handle mouse input for sliders and buttons
+    bool changed = false;
     for (auto& element : uiElements) {
         if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-            element->HandleClick(mousePoint);
+            bool was_hovered = element->IsHovered();
+            changed |= element->HandleClick(mousePoint);
+            if (element->IsHovered() != was_hovered) MarkDirty();
         }
     }
 
-    // Update volumes based on slider values
-    UpdateVolumes();
-
-    if (musicLoaded && IsMusicReady(menu_theme)) {
-        UpdateMusicStream(menu_theme);
-
-    if (!IsMusicStreamPlaying(menu_theme)) {
-            PlayMusicStream(menu_theme);
-        }
+    // Only touch the mixer when a slider actually moved
+    if (changed) {
+        UpdateVolumes();
+        MarkDirty();
     }
 }
 
 void SettingsScene::UpdateVolumes() {
-    // Update master volume
-    AudioManager::GetInstance()->SetMasterVolume(masterVolumeSlider->GetValue());
-
-    // Note: In a more advanced implementation, you'd separately track 
-    // music and SFX volumes
+    AudioManager* audio = AudioManager::GetInstance();
+    audio->SetBusVolume(BUS_MASTER, masterVolumeSlider->GetValue());
+    audio->SetBusVolume(BUS_MUSIC, musicVolumeSlider->GetValue());
+    audio->SetBusVolume(BUS_SFX, sfxVolumeSlider->GetValue());
 }
 
 void SettingsScene::Draw() {
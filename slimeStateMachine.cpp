@@ -24,6 +24,7 @@ void Slime::Update(float delta_time) {
         if (playOnce) {
             if (currentFrame < animationStartFrame + maxFrames - 1) {
                 currentFrame++;
+                if (currentFrame == animationStartFrame + maxFrames - 1) animation_done.Notify();
             }
 
         } else {
@@ -84,6 +85,7 @@ void Slime::Draw() {
 }
 
 void Slime::SetState(SlimeState* new_state) {
+    StopBehavior();
     current_state = new_state;
     current_state->Enter(*this);
 }
@@ -93,7 +95,7 @@ void Slime::HandleCollision(Entity* other_entity) {
 }
 
 Slime::Slime(Vector2 pos, float spd, float rad, float d_radius, float a_radius, float r_radius, int hp) {
-    enemyID = 0;
+    enemyID = ENEMY_SLIME;
     position = pos;
     speed = spd;
     radius = rad;
@@ -108,7 +110,10 @@ Slime::Slime(Vector2 pos, float spd, float rad, float d_radius, float a_radius,
     flash_timer = 0.0f;
     flash_interval = 0.1f;
 
-    sprite = LoadTexture(GAME_SCENE_SPRITE_SLIME);
+    static ResourceHandle shared_sprite;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    sprite_handle = resources->AcquireShared(shared_sprite, GAME_SCENE_SPRITE_SLIME, ResourceType::TEXTURE);
+    sprite = resources->GetTexture(sprite_handle).texture;
     frameWidth = (float) (sprite.width/ 35);
     frameHeight = (float) (sprite.height /4);
     currentFrame = 0;
@@ -125,11 +130,9 @@ void slimeWandering::Enter(Slime& slime) {
     slime.playOnce = false;
     slime.color = VIOLET;
     slime.speed = 5.0f;
-    change_direction_cooldown = GetRandomValue(1, 3);
-    move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-    move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-
-    move_direction = Vector2Normalize(move_direction);
+    float first_turn = GetRandomValue(1, 3);
+    move_direction = BaseEnemy::RandomDirection();
+    slime.RunBehavior(BaseEnemy::WanderTurns(move_direction, first_turn));
     slime.entity_following = nullptr;
 
     slime.animationStartFrame = 27;
@@ -161,22 +164,17 @@ void slimeAttacking::Enter(Slime&slime) {
     slime.maxFrames = 10;
     slime.currentFrame = slime.animationStartFrame;
     slime.frameSpeed = 0.1f;
-}
 
-void slimeWandering::Update(Slime& slime, float delta_time) {
-    slime.velocity = Vector2Zero();
+    finished = false;
+    slime.RunBehavior(Slime::AttackRecovery(slime));
+}
 
-    if (change_direction_cooldown <= 0.0f) {
-        move_direction.x = GetRandomValue(-100.0f, 100.0f) / 100.0f;
-        move_direction.y = GetRandomValue(-100.0f, 100.0f) / 100.0f;
+Behavior Slime::AttackRecovery(Slime& slime) {
+    co_await Behavior::AnimationDone(slime);
+    slime.attack.finished = true;
+}
 
-        move_direction = Vector2Normalize(move_direction);
-        
-        change_direction_cooldown = GetRandomValue(1, 3);
-    }
-    else {
-        change_direction_cooldown -= delta_time;
-    }
+void slimeWandering::Update(Slime& slime, float delta_time) {
     slime.velocity = Vector2Scale(move_direction, 50.0f);
 
     if (abs(slime.velocity.x) > abs(slime.velocity.y)){
@@ -195,19 +193,19 @@ void slimeWandering::Update(Slime& slime, float delta_time) {
         }
     }
 
+    slime.velocity = Vector2Add(slime.velocity, slime.separation);
+
     Vector2 new_position = Vector2Add(slime.position, Vector2Scale(slime.velocity, delta_time));
 
-    Slime temp_enemy = slime;
+    Entity temp_enemy = slime;
     temp_enemy.position = new_position;
 
     if (slime.tile_map && !slime.tile_map->CheckTileCollision(&temp_enemy)) {
         slime.position = new_position;
     } else {
         // Pick a new random direction if collision happens
-        move_direction.x = GetRandomValue(-100, 100) / 100.0f;
-        move_direction.y = GetRandomValue(-100, 100) / 100.0f;
-        move_direction = Vector2Normalize(move_direction);
-        change_direction_cooldown = GetRandomValue(1, 3);  // reset cooldown
+        move_direction = BaseEnemy::RandomDirection();
+        slime.RunBehavior(BaseEnemy::WanderTurns(move_direction, GetRandomValue(1, 3)));  // reset cooldown
     }
     
 
@@ -241,9 +239,11 @@ void slimeChasing::Update(Slime& slime, float delta_time) {
         }
     }
 
+    slime.velocity = Vector2Add(slime.velocity, slime.separation);
+
     Vector2 new_position = Vector2Add(slime.position, Vector2Scale(slime.velocity, delta_time));
 
-    Slime temp_enemy = slime;
+    Entity temp_enemy = slime;
     temp_enemy.position = new_position;
 
     if(slime.tile_map && !slime.tile_map->CheckTileCollision(&temp_enemy)) {
@@ -275,7 +275,7 @@ void slimeAttacking::Update(Slime&slime, float delta_time) {
 }
 
 void slimeWandering::HandleCollision(Slime& slime, Entity* other_entity) {
-    if (CheckCollisionCircles(slime.position, slime.detection_radius, other_entity->position, other_entity->radius)) {
+    if (CheckCollisionCircles(slime.position, slime.detection_radius, other_entity->position, other_entity->radius) && slime.CanSeePlayer()) {
         slime.entity_following = other_entity;
         slime.SetState(&slime.chasing);
     }
@@ -286,15 +286,60 @@ void slimeChasing::HandleCollision(Slime& slime, Entity* other_entity) {
         slime.SetState(&slime.wandering);
     }
 
-    if(CheckCollisionCircles(slime.position, slime.ready_attack_radius, other_entity->position, other_entity->radius)) {
+    if(CheckCollisionCircles(slime.position, slime.ready_attack_radius, other_entity->position, other_entity->radius) &&
+       slime.HasLineOfSight(other_entity->position)) {
         slime.SetState(&slime.attack);
     }
 }
 
 void slimeAttacking::HandleCollision(Slime&slime, Entity* other_entity) {
     if(!CheckCollisionCircles(slime.position, slime.ready_attack_radius, other_entity->position, other_entity->radius)) {
-        if (slime.currentFrame >= slime.animationStartFrame + slime.maxFrames - 1) {
+        if (finished) {
             slime.SetState(&slime.chasing);
         }
     }
-}
\ No newline at end of file
+}
+
+template <typename Archive>
+void Slime::Snapshot(Archive& archive, Entity* player) {
+    SnapshotBase(archive, player);
+
+    SlimeState* states[] = { &wandering, &chasing, &attack };
+    int state = 0;
+    for (int i = 0; i < 3; i++) {
+        if (current_state == states[i]) state = i;
+    }
+    archive.Value(state);
+    if (Archive::reading) current_state = states[(state >= 0 && state < 3) ? state : 0];
+
+    // The coroutine's frame isn't saved, only how long its delay had left
+    float change_direction_cooldown = current_state == &wandering ? BehaviorRemaining() : 0.0f;
+    archive.Value(change_direction_cooldown);
+    archive.Value(wandering.move_direction);
+    archive.Value(attack.attack_direction);
+    archive.Value(animation_state);
+    archive.Value(animationStartFrame);
+    archive.Value(playOnce);
+    archive.Value(flash_visible);
+    archive.Value(flash_timer);
+    archive.Value(flash_interval);
+
+    if (Archive::reading) {
+        if (current_state == &wandering) {
+            RunBehavior(BaseEnemy::WanderTurns(wandering.move_direction, change_direction_cooldown));
+        } else if (current_state == &attack) {
+            attack.finished = false;
+            RunBehavior(AttackRecovery(*this));
+        } else {
+            StopBehavior();
+        }
+    }
+}
+
+void Slime::WriteSnapshot(SnapshotWriter& writer) {
+    Snapshot(writer, nullptr);
+}
+
+void Slime::ReadSnapshot(SnapshotReader& reader, Entity* player) {
+    Snapshot(reader, player);
+}
@@ -0,0 +1,99 @@
+// Measures Level snapshot size and save/load time with thousands of enemies.
+//
+//   ./snapshot_bench [enemy count] [iterations]
+//
+// Needs a (hidden) window because entities upload their sprites on creation.
+
+#include <raylib.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "level.cpp"
+
+struct SnapshotBenchmark {
+    int entities;
+    size_t bytes;
+    double save_ms;
+    double load_ms;
+};
+
+// Friend of Level, so the bench can fill it without a gameplay API for it
+struct LevelSnapshotBench {
+    // Times SaveSnapshot/LoadSnapshot with enemy_count extra enemies, then
+    // puts the level back the way it was
+    static SnapshotBenchmark Run(Level& level, int enemy_count, int iterations) {
+        if (level.player == nullptr) {
+            level.map.LoadTilemapData("TileInfo.txt");
+            level.player = new Player(level.map.playerPos, 15.0f, 150.0f, level.starting_player_health);
+            level.player->setTileMap(&level.map);
+        }
+        Player* player = level.player;
+
+        std::string original = level.SaveSnapshot();
+
+        for (int i = 0; i < enemy_count; i++) {
+            int enemy_id = i % 3;
+            Vector2 spawn = { (float)GetRandomValue(32, 1250), (float)GetRandomValue(32, 850) };
+            level.enemies.push_back(level.CreateEnemy(enemy_id, spawn));
+            level.registry.OnSpawn(enemy_id);
+        }
+        for (int i = 0; i < enemy_count / 4; i++) {
+            Vector2 velocity = { (float)GetRandomValue(-300, 300), (float)GetRandomValue(-300, 300) };
+            player->projectiles.push_back(Projectile(player->position, velocity, 5.0f, player->projectileSprite, WHITE));
+        }
+
+        SnapshotBenchmark result = {0};
+        result.entities = 1 + (int)level.enemies.size() + (int)player->projectiles.size();
+
+        std::string bytes;
+        auto save_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            bytes = level.SaveSnapshot();
+        }
+        result.save_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - save_start).count() / iterations;
+        result.bytes = bytes.size();
+
+        auto load_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            level.LoadSnapshot(bytes);
+        }
+        result.load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count() / iterations;
+
+        level.LoadSnapshot(original);
+        return result;
+    }
+};
+
+int main(int argc, char** argv) {
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 20;
+    int counts[] = { 100, 1000, 5000 };
+    int count_total = 3;
+    if (argc > 1) {
+        counts[0] = std::stoi(argv[1]);
+        count_total = 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "snapshot_bench");
+
+    // Entity constructors and Level are chatty; report on the real stdout
+    // and drop everything else
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(nullptr);
+
+    for (int i = 0; i < count_total; i++) {
+        Level level(1);
+        SnapshotBenchmark result = LevelSnapshotBench::Run(level, counts[i], iterations);
+
+        report << result.entities << " entities: " << result.bytes << " bytes ("
+               << (double)result.bytes / result.entities << " per entity), save "
+               << result.save_ms << " ms, load " << result.load_ms << " ms" << std::endl;
+    }
+
+    SaveSystem::GetInstance()->Shutdown();
+    ResourceManager::GetInstance()->UnloadAll();
+    CloseWindow();
+    return 0;
+}
@@ -8,6 +8,8 @@
 class TitleScene : public Scene {
 
 public:
+    TitleScene();
+
     void Begin() override;
     void End() override;
     void Update() override;
@@ -16,8 +18,8 @@ public:
 private:
     Texture eyeball;
     Texture cavebg;
-    Music title_theme = {0};
-    bool musicLoaded = false;
+    ResourceHandle eyeball_handle;
+    ResourceHandle cavebg_handle;
 };
 
 #endif
\ No newline at end of file
@@ -2,33 +2,23 @@
 #include "scene_manager.hpp"
 #include <iostream>
 
+TitleScene::TitleScene() {
+    draws_on_demand = true;
+}
+
 void TitleScene::Begin() {
-    TextureData eyeballTextureData = ResourceManager::GetInstance()->GetTexture("eyeball.png");
-    eyeball = eyeballTextureData.texture;
-    TextureData caveTexture = ResourceManager::GetInstance()->GetTexture("back_cave.png");
-    cavebg = caveTexture.texture;
+    ResourceManager* resources = ResourceManager::GetInstance();
+    eyeball_handle = resources->AcquireTexture("eyeball.png");
+    cavebg_handle = resources->AcquireTexture("back_cave.png");
+    eyeball = resources->GetTexture(eyeball_handle).texture;
+    cavebg = resources->GetTexture(cavebg_handle).texture;
 
-    if (!IsMusicReady(title_theme)) {
-        title_theme = LoadMusicStream("title-theme.mp3");
-    }
-    
-    if (IsMusicReady(title_theme)) {
-        musicLoaded = true;
-        AudioManager::GetInstance()->SetCurrentMusic(title_theme);
-        PlayMusicStream(title_theme);
-    } else {
-        std::cerr << "Failed to load menu theme music" << std::endl;
-    }
+    AudioManager::GetInstance()->PlayMusic("title-theme.mp3");
 }
 
 void TitleScene::End() {
-    if (IsMusicReady(title_theme)) {
-        StopMusicStream(title_theme);
-        UnloadMusicStream(title_theme);
-        
-        title_theme = {0};
-        musicLoaded = false;
-    }   
+    ResourceManager::GetInstance()->Release(eyeball_handle);
+    ResourceManager::GetInstance()->Release(cavebg_handle);
 }
 
 void TitleScene::Update() {
@@ -37,14 +27,6 @@ void TitleScene::Update() {
             GetSceneManager()->SwitchScene(1);
         }
     }
-
-    if (musicLoaded && IsMusicReady(title_theme)) {
-        UpdateMusicStream(title_theme);
-
-        if (!IsMusicStreamPlaying(title_theme)) {
-            PlayMusicStream(title_theme);
-        }
-    }
 }
 
 void TitleScene::Draw() {